@@ -0,0 +1,495 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_benchmark.cpp
+ * \brief The headless stress benchmark of the HiEasyX pipeline
+ */
+
+#include <include/hex.h>
+#include <include/hex_button.h>
+#include <include/hex_text.h>
+#include <include/hex_window.h>
+#include <include/impl/Software/hex_impl_software.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// The library counts its allocations through its hooks, the ones bypassing
+// them like the strings copied by the widgets are caught by counting the
+// global operator new too. Every form of it is replaced, so the aligned
+// allocations like the cache line aligned queues are counted as well
+namespace {
+std::atomic<uint64_t> UntrackedAllocations = 0;
+
+bool _OverAligned(size_t Alignment) {
+	return Alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+}
+
+void *_Allocate(size_t Size, size_t Alignment) {
+	UntrackedAllocations.fetch_add(1, std::memory_order_relaxed);
+
+	Size = Size != 0 ? Size : 1;
+	if (!_OverAligned(Alignment)) {
+		return std::malloc(Size);
+	}
+
+#ifdef _MSC_VER
+	return _aligned_malloc(Size, Alignment);
+#else
+	// The size given to aligned_alloc must be a multiple of the alignment
+	return std::aligned_alloc(Alignment, (Size + Alignment - 1) / Alignment * Alignment);
+#endif
+}
+
+void *_AllocateOrThrow(size_t Size, size_t Alignment) {
+	if (auto memory = _Allocate(Size, Alignment)) {
+		return memory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void _Release(void *Memory, [[maybe_unused]] size_t Alignment) {
+#ifdef _MSC_VER
+	if (_OverAligned(Alignment)) {
+		_aligned_free(Memory);
+
+		return;
+	}
+#endif
+	std::free(Memory);
+}
+}
+
+void *operator new(size_t Size) {
+	return _AllocateOrThrow(Size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new[](size_t Size) {
+	return _AllocateOrThrow(Size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new(size_t Size, std::align_val_t Alignment) {
+	return _AllocateOrThrow(Size, static_cast<size_t>(Alignment));
+}
+
+void *operator new[](size_t Size, std::align_val_t Alignment) {
+	return _AllocateOrThrow(Size, static_cast<size_t>(Alignment));
+}
+
+void *operator new(size_t Size, const std::nothrow_t &) noexcept {
+	return _Allocate(Size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new[](size_t Size, const std::nothrow_t &) noexcept {
+	return _Allocate(Size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new(size_t Size, std::align_val_t Alignment, const std::nothrow_t &) noexcept {
+	return _Allocate(Size, static_cast<size_t>(Alignment));
+}
+
+void *operator new[](size_t Size, std::align_val_t Alignment, const std::nothrow_t &) noexcept {
+	return _Allocate(Size, static_cast<size_t>(Alignment));
+}
+
+void operator delete(void *Memory) noexcept {
+	_Release(Memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete[](void *Memory) noexcept {
+	_Release(Memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void *Memory, size_t) noexcept {
+	_Release(Memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete[](void *Memory, size_t) noexcept {
+	_Release(Memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void *Memory, std::align_val_t Alignment) noexcept {
+	_Release(Memory, static_cast<size_t>(Alignment));
+}
+
+void operator delete[](void *Memory, std::align_val_t Alignment) noexcept {
+	_Release(Memory, static_cast<size_t>(Alignment));
+}
+
+void operator delete(void *Memory, size_t, std::align_val_t Alignment) noexcept {
+	_Release(Memory, static_cast<size_t>(Alignment));
+}
+
+void operator delete[](void *Memory, size_t, std::align_val_t Alignment) noexcept {
+	_Release(Memory, static_cast<size_t>(Alignment));
+}
+
+void operator delete(void *Memory, const std::nothrow_t &) noexcept {
+	_Release(Memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete[](void *Memory, const std::nothrow_t &) noexcept {
+	_Release(Memory, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void operator delete(void *Memory, std::align_val_t Alignment, const std::nothrow_t &) noexcept {
+	_Release(Memory, static_cast<size_t>(Alignment));
+}
+
+void operator delete[](void *Memory, std::align_val_t Alignment, const std::nothrow_t &) noexcept {
+	_Release(Memory, static_cast<size_t>(Alignment));
+}
+
+namespace {
+constexpr HXGInt SurfaceWidth  = 1920;
+constexpr HXGInt SurfaceHeight = 1080;
+
+/**
+ * The state shared by the frames of a workload
+ */
+struct Workload {
+	// The titles and the labels are built before measuring, so building
+	// them is not counted as the allocations of the pipeline
+	std::vector<HXString> Titles;
+	std::vector<HXString> Labels;
+
+	// The deterministic random state of the input replayed
+	uint32_t Seed = 0x9E3779B9u;
+};
+
+/**
+ * A synthetic workload, the frame function lays out one frame between
+ * HX::Begin and HX::End
+ */
+struct Scenario {
+	const char *Name;
+	size_t      Windows;
+	size_t      Labels;
+	void (*Frame)(Workload &State, uint32_t Frame);
+};
+
+/**
+ * The measurements of a workload, the times are in microseconds
+ */
+struct Report {
+	double   P50         = 0;
+	double   P90         = 0;
+	double   P99         = 0;
+	double   Max         = 0;
+	double   Allocations = 0;
+	double   Bytes       = 0;
+	double   Untracked   = 0;
+	double   DrawCalls   = 0;
+	double   Replayed    = 0;
+	uint64_t Messages    = 0;
+};
+
+HXString _MakeName(const char *Prefix, size_t Index) {
+	HXString name;
+	for (; *Prefix != '\0'; ++Prefix) {
+		name.push_back(static_cast<HXString::value_type>(*Prefix));
+	}
+
+	char digits[24];
+	const int length = std::snprintf(digits, sizeof(digits), "%zu", Index);
+	for (int character = 0; character < length; ++character) {
+		name.push_back(static_cast<HXString::value_type>(digits[character]));
+	}
+
+	return name;
+}
+
+uint32_t _NextRandom(uint32_t &Seed) {
+	Seed ^= Seed << 13;
+	Seed ^= Seed >> 17;
+	Seed ^= Seed << 5;
+
+	return Seed;
+}
+
+void _PushMouse(HXSoftwareMessageType Type, HXGInt X, HXGInt Y) {
+	HXSoftwareMessage message{.Type = Type, .X = X, .Y = Y};
+	HX::PushMessage(HX::GetHXMessage(&message));
+}
+
+// One tall window holding a long list of labels
+void _LabelsFrame(Workload &State, uint32_t) {
+	static HX::WindowProfile profile = [] {
+		auto result = HX::WindowProfile{};
+		result.Size = {SurfaceWidth, SurfaceHeight};
+
+		return result;
+	}();
+
+	HX::Window(State.Titles[0], profile);
+	for (auto &label : State.Labels) {
+		HX::Text(label);
+	}
+}
+
+// The same list with its first label changing every frame, so the window is
+// replayed every frame instead of only being composited
+void _DirtyLabelsFrame(Workload &State, uint32_t Frame) {
+	State.Labels[0].back() = static_cast<HXString::value_type>('0' + Frame % 10);
+
+	_LabelsFrame(State, Frame);
+}
+
+// The same window with a million labels clipped to the visible ones
+void _ClippedLabelsFrame(Workload &State, uint32_t) {
+	static HX::WindowProfile profile = [] {
+		auto result = HX::WindowProfile{};
+		result.Size = {SurfaceWidth, SurfaceHeight};
+
+		return result;
+	}();
+
+	HX::Window(State.Titles[0], profile);
+	HX::ClipList(1000000, 0, [&State](size_t Index) {
+		HX::Text(State.Labels[Index % State.Labels.size()]);
+	});
+}
+
+// A scroll region of buttons rolled by the wheel every frame, the buttons out
+// of the viewport are only laid out
+void _ScrollFrame(Workload &State, uint32_t Frame) {
+	static HX::WindowProfile profile = [] {
+		auto result = HX::WindowProfile{};
+		result.Size = {SurfaceWidth, SurfaceHeight};
+
+		return result;
+	}();
+	static HX::ScrollProfile scroll = [] {
+		auto result = HX::ScrollProfile{};
+		result.Size = {0, SurfaceHeight - 100};
+
+		return result;
+	}();
+
+	HXSoftwareMessage message{.Type  = HXSoftwareMessageType::MouseWheel,
+	                          .X     = SurfaceWidth / 2,
+	                          .Y     = SurfaceHeight / 2,
+	                          .Wheel = Frame % 512 < 256 ? -120 : 120};
+	HX::PushMessage(HX::GetHXMessage(&message));
+
+	HX::Window(State.Titles[0], profile);
+	HX::BeginScroll(State.Titles[0], scroll);
+	for (auto &label : State.Labels) {
+		HX::Button(label);
+	}
+	HX::EndScroll();
+}
+
+// A dashboard of four columns in a window resized every frame, the columns
+// are solved again only when the width has changed
+void _DashboardFrame(Workload &State, uint32_t Frame) {
+	static HX::WindowProfile profile = [] {
+		auto result = HX::WindowProfile{};
+		result.Size = {SurfaceWidth, SurfaceHeight};
+
+		return result;
+	}();
+	profile.Size.X = SurfaceWidth - static_cast<HXGInt>(Frame % 64) * 8;
+
+	static constexpr HX::LayoutSize columns[] = {HX::Fixed(160), HX::Flex(2), HX::Flex(1), HX::Auto()};
+
+	HX::Window(State.Titles[0], profile);
+	HX::BeginRow("Dashboard", columns);
+	for (auto &label : State.Labels) {
+		HX::Text(label);
+	}
+	HX::EndLayout();
+}
+
+// Many small windows each holding a column of buttons
+void _WindowsFrame(Workload &State, uint32_t) {
+	for (size_t window = 0; window < State.Titles.size(); ++window) {
+		HX::Window(State.Titles[window]);
+		for (size_t button = 0; button < State.Labels.size(); ++button) {
+			HX::Button(State.Labels[button]);
+		}
+	}
+}
+
+// A few windows bombarded by a storm of mouse moves and clicks
+void _MouseStormFrame(Workload &State, uint32_t Frame) {
+	for (int message = 0; message < 256; ++message) {
+		const auto random = _NextRandom(State.Seed);
+		const auto x      = static_cast<HXGInt>(random % SurfaceWidth);
+		const auto y      = static_cast<HXGInt>((random >> 16) % SurfaceHeight);
+		switch (random % 16) {
+		case 0:
+			_PushMouse(HXSoftwareMessageType::MouseLeftDown, x, y);
+			break;
+		case 1:
+			_PushMouse(HXSoftwareMessageType::MouseLeftUp, x, y);
+			break;
+		default:
+			_PushMouse(HXSoftwareMessageType::MouseMove, x, y);
+			break;
+		}
+	}
+
+	_WindowsFrame(State, Frame);
+}
+
+const Scenario Scenarios[] = {
+	{"labels_1x10000", 1, 10000, _LabelsFrame},
+	{"labels_dirty_1x10000", 1, 10000, _DirtyLabelsFrame},
+	{"labels_clipped_1x1000000", 1, 1000, _ClippedLabelsFrame},
+	{"scroll_buttons_1x10000", 1, 10000, _ScrollFrame},
+	{"dashboard_resize_1x2000", 1, 2000, _DashboardFrame},
+	{"windows_500x20", 500, 20, _WindowsFrame},
+	{"mouse_storm_16x20", 16, 20, _MouseStormFrame},
+};
+
+double _Percentile(const std::vector<uint64_t> &Sorted, double Rank) {
+	const auto index = static_cast<size_t>(Rank * static_cast<double>(Sorted.size() - 1) + 0.5);
+
+	return static_cast<double>(Sorted[index]) / 1000.0;
+}
+
+Report _Run(const Scenario &Scene, uint32_t Frames, uint32_t WarmUp, bool Parallel) {
+	std::vector<HXBuffer> pixels(static_cast<size_t>(SurfaceWidth) * SurfaceHeight);
+	HXSoftwareBuffer      device{pixels.data(), SurfaceWidth, SurfaceHeight};
+
+	Workload state;
+	for (size_t window = 0; window < Scene.Windows; ++window) {
+		state.Titles.push_back(_MakeName("Window ", window));
+	}
+	for (size_t label = 0; label < Scene.Labels; ++label) {
+		state.Labels.push_back(_MakeName("Item ", label));
+	}
+
+	// Every workload starts from an empty context
+	auto context = HX::CreateContext();
+	HX::SetCurrentContext(context);
+	HX::HXInitForSoftware(&device);
+	HX::SetParallelRender(Parallel);
+
+	std::vector<uint64_t> times;
+	times.reserve(Frames);
+
+	Report   report;
+	uint64_t allocations = 0;
+	uint64_t bytes       = 0;
+	uint64_t untracked   = 0;
+	uint64_t drawCalls   = 0;
+	uint64_t replayed    = 0;
+	for (uint32_t frame = 0; frame < WarmUp + Frames; ++frame) {
+		const auto allocated = UntrackedAllocations.load(std::memory_order_relaxed);
+		const auto start     = std::chrono::steady_clock::now();
+
+		HX::HXBegin();
+		Scene.Frame(state, frame);
+		HX::End();
+		HX::SetBuffer(HX::GetHXBuffer(&device));
+		HX::Render();
+
+		const auto end = std::chrono::steady_clock::now();
+		if (frame < WarmUp) {
+			continue;
+		}
+
+		const auto &stats = HX::GetFrameStats();
+		times.push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+		allocations += stats.Allocations;
+		bytes += stats.AllocatedBytes;
+		untracked += UntrackedAllocations.load(std::memory_order_relaxed) - allocated;
+		drawCalls += stats.DrawCommands;
+		replayed += stats.WindowsReplayed;
+		report.Messages += stats.Messages;
+	}
+
+	HX::DestroyContext(context);
+
+	std::sort(times.begin(), times.end());
+	report.P50         = _Percentile(times, 0.50);
+	report.P90         = _Percentile(times, 0.90);
+	report.P99         = _Percentile(times, 0.99);
+	report.Max         = static_cast<double>(times.back()) / 1000.0;
+	report.Allocations = static_cast<double>(allocations) / Frames;
+	report.Bytes       = static_cast<double>(bytes) / Frames;
+	report.Untracked   = static_cast<double>(untracked) / Frames;
+	report.DrawCalls   = static_cast<double>(drawCalls) / Frames;
+	report.Replayed    = static_cast<double>(replayed) / Frames;
+
+	return report;
+}
+
+void _PrintUsage(const char *Program) {
+	std::printf("Usage: %s [--frames N] [--warmup N] [--parallel] [scenario...]\n", Program);
+	std::printf("Scenarios:");
+	for (auto &scene : Scenarios) {
+		std::printf(" %s", scene.Name);
+	}
+	std::printf("\n");
+}
+}
+
+int main(int Argc, char **Argv) {
+	uint32_t                  frames   = 300;
+	uint32_t                  warmUp   = 30;
+	bool                      parallel = false;
+	std::vector<const char *> filters;
+	for (int argument = 1; argument < Argc; ++argument) {
+		const std::string_view option = Argv[argument];
+		if (option == "--frames" && argument + 1 < Argc) {
+			frames = static_cast<uint32_t>(std::max(1L, std::strtol(Argv[++argument], nullptr, 10)));
+		} else if (option == "--warmup" && argument + 1 < Argc) {
+			warmUp = static_cast<uint32_t>(std::max(0L, std::strtol(Argv[++argument], nullptr, 10)));
+		} else if (option == "--parallel") {
+			parallel = true;
+		} else if (option == "--help" || option.starts_with("-")) {
+			_PrintUsage(Argv[0]);
+
+			return option == "--help" ? 0 : 1;
+		} else {
+			filters.push_back(Argv[argument]);
+		}
+	}
+
+	std::printf("%-26s %10s %10s %10s %10s %12s %12s %12s %10s %10s %10s\n", "scenario", "p50(us)", "p90(us)",
+	            "p99(us)", "max(us)", "allocs/frm", "bytes/frm", "other/frm", "draws/frm", "repl/frm", "messages");
+	for (auto &scene : Scenarios) {
+		if (!filters.empty() && std::none_of(filters.begin(), filters.end(), [&scene](const char *Filter) {
+			return std::string_view(scene.Name) == Filter;
+		})) {
+			continue;
+		}
+
+		const auto report = _Run(scene, frames, warmUp, parallel);
+		std::printf("%-26s %10.1f %10.1f %10.1f %10.1f %12.2f %12.1f %12.2f %10.1f %10.2f %10llu\n", scene.Name,
+		            report.P50, report.P90, report.P99, report.Max, report.Allocations, report.Bytes, report.Untracked,
+		            report.DrawCalls, report.Replayed, static_cast<unsigned long long>(report.Messages));
+	}
+
+	return 0;
+}
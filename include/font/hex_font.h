@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <include/hex_hash.h>
 #include <include/hex_string.h>
 
 /**
@@ -49,6 +50,88 @@ struct HXFont {
 		Family = "Microsoft YaHei";
 		Style  = HXFontStyle::Regular;
 		Italic = false;
+#else
+		Family = "Sans";
+		Style  = HXFontStyle::Regular;
+		Italic = false;
 #endif
 	}
+
+	bool operator==(const HXFont &) const = default;
+};
+
+/**
+ * Calculating the key of a font, which identifies the family, the style
+ * and the italic setting of the font
+ * @param Font The font to be identified
+ * @return The key of the font
+ */
+inline HXHash HXFontKey(const HXFont &Font) {
+	const auto hash = HXHashString(Font.Family.data(), Font.Family.size());
+
+	return HXHashCombine(hash, static_cast<uint64_t>(Font.Style) << 1 | static_cast<uint64_t>(Font.Italic));
+}
+
+/**
+ * An interned font, the record is never released once interned, so the
+ * handles referring to it stay valid for the whole program
+ */
+struct HXInternedFont {
+	HXFont Font;
+	HXHash Key;
+
+	// The order of the font being interned, starting from zero
+	uint32_t Index;
+};
+
+/**
+ * The handle of an interned font, which is as cheap as a pointer to copy
+ * and compare. A font is interned only once, every later handle of an
+ * equal font refers to the same record
+ */
+class HXFontHandle {
+public:
+	/**
+	 * Constructing the handle of the default font
+	 */
+	HXFontHandle();
+
+	/**
+	 * Interning a font and constructing its handle, the interning takes
+	 * the lock of the font table, so the handle should be kept instead of
+	 * being made again for every draw
+	 * @param Font The font to be interned
+	 */
+	explicit HXFontHandle(const HXFont &Font);
+
+public:
+	/**
+	 * Getting the font referred by the handle
+	 * @return The font interned
+	 */
+	const HXFont &Font() const {
+		return _font->Font;
+	}
+
+	/**
+	 * Getting the key of the font referred by the handle
+	 * @return The same value as HXFontKey of the font
+	 */
+	HXHash Key() const {
+		return _font->Key;
+	}
+
+	/**
+	 * Getting the index of the font referred by the handle, the index is
+	 * dense so the implementations can keep their per font state in arrays
+	 * @return The index of the font interned
+	 */
+	uint32_t Index() const {
+		return _font->Index;
+	}
+
+	bool operator==(const HXFontHandle &) const = default;
+
+private:
+	const HXInternedFont *_font;
 };
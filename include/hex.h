@@ -29,21 +29,90 @@
 
 #include <include/hex_string.h>
 #include <include/impl/hex_impl.h>
+#include <include/hex_draw_list.h>
+#include <include/hex_frame_arena.h>
+#include <include/hex_measure_cache.h>
+#include <include/hex_memory.h>
+#include <include/hex_hit_grid.h>
+#include <include/hex_id.h>
+#include <include/hex_state_table.h>
+#include <include/hex_message_queue.h>
+#include <include/hex_profiler.h>
+#include <include/hex_spsc_queue.h>
+#include <include/hex_thread_pool.h>
 #include <include/hex_button.h>
 #include <include/hex_window.h>
 #include <include/hex_text.h>
+#include <include/hex_list_clipper.h>
+#include <include/hex_layout.h>
+#include <include/hex_scroll.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <unordered_map>
 
 struct HXWindow;
 struct HXRuntimeContext;
 struct HXTheme;
 
+/**
+ * The message index meaning no message
+ */
+constexpr uint32_t HXNoMessage = UINT32_MAX;
+
+/**
+ * A tile of the target composited by a worker thread
+ */
+struct HXCompositeTile {
+	HXRuntimeContext *Context;
+	HXRect            Rect;
+};
+
+/**
+ * A message routed to a control of a window
+ */
+struct HXRoutedMessage {
+	// The order of the control in its window
+	uint32_t Control;
+
+	// The index of the message in the message query
+	uint32_t Message;
+};
+
 namespace HX {
 /**
  * Get the runtime context of HiEasyX
- * @return The runtime context of HiEasyX
+ * @return The runtime context current on the calling thread
  */
 HXRuntimeContext &GetContext();
 
+/**
+ * Creating an independent runtime context, every context owns its windows,
+ * messages and theme, so the contexts current on different threads can run
+ * their UI layouts at the same time. The new context gets the default theme
+ * but no message sender, the backend should be initialized again after
+ * selecting it
+ * @return The created context
+ */
+HXRuntimeContext *CreateContext();
+
+/**
+ * Destroying a context created by HX::CreateContext, the calling thread
+ * falls back to the default context if the context was current on it
+ * @param Context The context to be destroyed
+ */
+void DestroyContext(HXRuntimeContext *Context);
+
+/**
+ * Selecting the context the calling thread works with, which can be current
+ * on only one thread at a time
+ * @param Context The context to be selected, nullptr for the default context
+ */
+void SetCurrentContext(HXRuntimeContext *Context);
+
 /**
  * Get the theme of the HiEasyX
  * @return The theme of the HiEasyX
@@ -86,12 +155,22 @@ void Begin(HXContext *RenderContext);
 void MessageSender(HXMessageSender *Sender);
 
 /**
- * Pushing the message to the message query
+ * Pushing the message to the input queue, which is lock-free, so the
+ * messages can be pushed by one input thread while the UI thread is busy
+ * with a frame. The pushed messages are drained into the message query by
+ * HX::Begin and by the first window of the frame
  * @param Message The message to be pushed
- * @param Size The size of the message structure
  */
 void PushMessage(void *Message);
 
+/**
+ * Pushing the message to the input queue of a specified context, which is
+ * how an input thread feeds a context that is not current on it
+ * @param Context The context receiving the message
+ * @param Message The message to be pushed
+ */
+void PushMessage(HXRuntimeContext &Context, void *Message);
+
 /**
  * End the UI layout progress
  */
@@ -108,6 +187,216 @@ bool Wined();
  */
 void Render();
 
+/**
+ * Checking whether another frame has to be laid out and rendered, which is
+ * the case when messages are waiting, the last frame handled input or
+ * changed the target, the target is damaged, or a frame requested by
+ * HX::RequestFrame is due
+ * @return If a frame is needed, returning true, nor returning false
+ */
+bool NeedsFrame();
+
+/**
+ * Requesting a frame after a delay even if no input comes, which is how the
+ * animations and the timers keep the UI running
+ * @param Milliseconds The delay of the frame
+ */
+void RequestFrame(uint32_t Milliseconds = 0);
+
+/**
+ * Blocking the calling thread until a frame is needed, the wait ends with
+ * the next input, the next requested frame, or the timeout. It returns at
+ * once when a frame is already needed, so the host can call it at the end
+ * of every loop instead of sleeping
+ * @param Milliseconds The longest time to wait, UINT32_MAX waits forever
+ * @return If a frame is needed, returning true, nor returning false
+ */
+bool WaitForEvents(uint32_t Milliseconds = UINT32_MAX);
+
+/**
+ * Setting whether HX::Render draws the windows of the current context on
+ * the worker threads, which only takes effect when the implementation
+ * supports drawing different painters at the same time
+ * @param Enable If drawing in parallel, passing true, nor passing false
+ */
+void SetParallelRender(bool Enable);
+
+/**
+ * Getting the thread pool shared by all contexts, which is created on the
+ * first use with one worker less than the hardware threads
+ * @return The thread pool
+ */
+HXThreadPool &GetThreadPool();
+
+/**
+ * Marking the whole target as damaged, the next HX::Render will composite
+ * every window in full, the host should call it whenever the content of
+ * the target buffer is lost, like the target being resized
+ */
+void Invalidate();
+
+/**
+ * Checking whether the whole target needs to be presented, which is the
+ * case for the first frame and after HX::Invalidate
+ * @return If the whole target is damaged, returning true, nor returning false
+ */
+bool IsFullyDamaged();
+
+/**
+ * Getting the regions damaged since the last HX::Render, the host only needs
+ * to repaint its background in and present these regions. The list is valid
+ * between HX::End and HX::Render, and is meaningless when the whole target
+ * is damaged
+ * @return The damaged regions, the right and the bottom edges are exclusive
+ */
+const HXVector<HXRect, HXMemoryTag::Painter> &GetDirtyRects();
+
+/**
+ * Getting the union of all damaged regions
+ * @return The union of the damaged regions, which is empty if nothing changed
+ */
+HXRect GetDirtyBounds();
+
+/**
+ * Measuring a text with the painter of the current window, the measurement
+ * is answered from the measurement cache whenever possible, the widgets
+ * should measure through it instead of asking the painter directly
+ * @param Text The text to be measured
+ * @param Font The font using to measure
+ * @param Height The height of the font
+ * @return The rectangle of the text measured
+ */
+HXRect MeasureText(HXStringView Text, HXFontHandle Font, HXGUInt Height);
+
+/**
+ * Getting the counters of the measurement cache
+ * @return The counters of the measurement cache
+ */
+const HXMeasureCacheStats &GetMeasureStats();
+
+/**
+ * Getting the arena of the current context, the memory allocated from it is
+ * valid until the next HX::Begin, which is where the transient data of a
+ * frame should live
+ * @return The arena of the current context
+ */
+HXFrameArena &GetFrameArena();
+
+/**
+ * Getting the counters of the message query
+ * @return The counters of the message query
+ */
+HXMessageQueueStats GetMessageStats();
+
+/**
+ * Setting whether the spans of the current context are recorded, the
+ * frame counters are always kept
+ * @param Enable If recording the spans, passing true, nor passing false
+ */
+void SetProfiling(bool Enable);
+
+/**
+ * Getting the profiler of the current context, which the widgets can use to
+ * record their own spans with HX_PROFILE_SCOPE
+ * @return The profiler of the current context
+ */
+HXProfiler &GetProfiler();
+
+/**
+ * Getting the counters of the current frame, which are complete after
+ * HX::Render
+ * @return The counters of the current frame
+ */
+const HXFrameStats &GetFrameStats();
+
+/**
+ * Writing the recorded spans and frame counters of the current context to
+ * a Chrome trace file, which should be done between the frames
+ * @param Path The path of the file
+ * @return If the file is written, returning true, nor returning false
+ */
+bool ExportTrace(const std::filesystem::path &Path);
+
+/**
+ * Getting the allocations made through the hooks by the current frame, from
+ * HX::Begin to the end of HX::Render, which are complete after HX::Render.
+ * The hooks count the whole process, so the frames of other contexts
+ * running at the same time are counted too
+ * @return The allocations of the current frame per subsystem
+ */
+const HXMemoryStats &GetFrameMemory();
+
+/**
+ * Setting the allocation guard of the current context. Once a frame of the
+ * context has run without allocating, the guard is armed for every later
+ * frame from HX::Begin to the end of HX::Render, so any allocation of the
+ * steady state is flagged. Setting the guard starts waiting for a steady
+ * frame again
+ * @param Mode The action of the guard on an allocation of a steady frame
+ */
+void SetAllocationGuard(HXAllocationGuard Mode);
+
+/**
+ * Getting the count of the steady frames of the current context which
+ * allocated while guarded
+ * @return The count of the frames flagged by the guard
+ */
+uint64_t GetAllocationViolations();
+
+/**
+ * Routing the pushed messages to the windows and the controls under the
+ * mouse, which is hit-tested against the layout of the last frame. The
+ * windows call it before processing their messages, every message is
+ * routed only once
+ */
+void RouteMessages();
+
+/**
+ * Registering an interactive control of the current window for the hit-test
+ * of the next frame, and getting the messages routed to the control. The
+ * controls are identified by the order they are registered in the window
+ * @param Rect The rectangle of the control relative to the window
+ * @return The messages routed to the control in this frame
+ */
+std::span<const HXRoutedMessage> ControlMessages(HXRect Rect);
+
+/**
+ * Checking whether a control of the current window can be seen, which is
+ * when it overlaps the visible region of the window narrowed by the scroll
+ * regions. A control entirely outside is neither drawn nor hit-tested
+ * @param Rect The rectangle of the control relative to the window, the
+ * right and the bottom edges are inclusive as for the hit-test
+ * @return If the control can be seen, returning true, nor returning false
+ */
+bool IsVisible(HXRect Rect);
+
+/**
+ * Pushing a label onto the identity stack, the identities of the widgets
+ * created after it are nested in the label until HX::PopID. It tells the
+ * widgets with the same label apart, like the ones created in a loop
+ * @param Label The label to be pushed
+ */
+void PushID(HXLabel Label);
+
+/**
+ * Pushing an index onto the identity stack
+ * @param Index The index to be pushed
+ */
+void PushID(int64_t Index);
+
+/**
+ * Popping the identity pushed by the last HX::PushID
+ */
+void PopID();
+
+/**
+ * Getting the identity of a label nested in the identity stack, the stack
+ * is rooted at the current window
+ * @param Label The label of the widget
+ * @return The identity of the widget
+ */
+HXID GetID(HXLabel Label);
+
 /**
  * Clipping the coord into the relative coord
  * @param Point The point needed to clip
@@ -135,21 +424,77 @@ enum class HXControlStatus {
  */
 struct HXControl {
 	HXControlType   Type;
-	HXString        Id;
+	HXID            Id;
 	HXControlStatus Status;
 };
 
 /**
- * The structure to store window, including title, position and controls
+ * The structure to store window, including title, position and controls,
+ * the window is kept by the runtime context across frames so that its
+ * painter can be reused
  */
 struct HXWindow {
+	HXID             Id = HXNoID;
 	HXString         Title;
-	HXPoint          Size;
-	HXPoint          Where;
-	HXBufferPainter *Painter;
-	bool             Folded;
+	HXPoint          Size     = {0, 0};
+	HXPoint          Where    = {0, 0};
+	HXBufferPainter *Painter  = nullptr;
+	bool             Folded   = false;
 	HXGInt           BaseLine = 50;
 
+	// The context owning the window, for the work done off the UI thread
+	HXRuntimeContext *Context = nullptr;
+
+	// The commands recorded by the window and its controls in this frame
+	HXDrawList DrawList = {};
+
+	// The size of the painter requested in this frame
+	HXPoint PainterSize = {0, 0};
+
+	// The region of the painter the controls can be seen in, which is the
+	// whole painter narrowed by the open scroll regions, the right and the
+	// bottom edges are exclusive
+	HXRect ClipRect = {0, 0, 0, 0};
+
+	// The hash of the content currently held by the painter, when the
+	// recorded commands hash to the same value the painter is not redrawn
+	HXHash ContentHash  = 0;
+	bool   ContentValid = false;
+
+	// The opacity the window is composited with in this frame
+	HXColInt Opacity = 255;
+
+	// Where and how the window was composited onto the target by the last
+	// HX::Render
+	HXRect   PresentedRect    = {0, 0, 0, 0};
+	HXColInt PresentedOpacity = 255;
+	bool     Presented        = false;
+
+	// The frame index when the window was submitted for the last time
+	uint64_t LastFrame = 0;
+
+	// The replay of the draw list when it is running on the thread pool
+	HXTaskGroup Replay = {};
+
+	// The rectangles of the controls registered in this frame relative to
+	// the window, and the grid built from them in HX::End
+	HXVector<HXRect, HXMemoryTag::Layout> ControlRects = {};
+	HXHitGrid                             ControlGrid  = {};
+
+	// The messages routed to the window in this frame, and the ones routed
+	// to its controls sorted by the order of the controls
+	HXVector<uint32_t, HXMemoryTag::Input>        Inbox         = {};
+	HXVector<HXRoutedMessage, HXMemoryTag::Input> ControlInbox  = {};
+	size_t                                        ControlCursor = 0;
+
+	// A captured window receives every mouse message exclusively, like when
+	// it is dragged or resized, a tracking window receives a copy of every
+	// mouse message, like when it has changed the cursor style
+	bool Captured = false;
+	bool Tracking = false;
+
+	HX_TAGGED_NEW(HXMemoryTag::Window)
+
 	~HXWindow() {
 		delete Painter;
 	}
@@ -177,13 +522,112 @@ struct HXTheme {
  * The runtime context, including all value for UI running
  */
 struct HXRuntimeContext {
-	std::vector<HXMessage>  MessageQuery;
-	std::vector<HXWindow *> Windows;
-	HXWindow *              CurrentWindow = nullptr;
-	HXContext *             RenderContext = nullptr;
-	HXOSOperation *         OSAPI         = nullptr;
-	void *                  LocalBuffer   = nullptr;
-	HXString                LastError;
-	bool                    Initialized = false;
-	bool                    Win         = true;
+	HXMessageQueue                            MessageQuery;
+	HXVector<HXWindow *, HXMemoryTag::Window> Windows;
+	HXWindow *                                CurrentWindow = nullptr;
+	HXContext *                               RenderContext = nullptr;
+	HXOSOperation *                           OSAPI         = nullptr;
+	void *                                    LocalBuffer   = nullptr;
+	HXString                                  LastError;
+	bool                                      Initialized = false;
+	bool                                      Win         = true;
+
+	// The look and the message translation of this context
+	HXTheme          Theme     = {};
+	HXMessageSender *MsgSender = nullptr;
+
+	// Whether the windows are drawn and composited on the thread pool, the
+	// tiles of the target composited in parallel by HX::Render
+	bool                                            ParallelRender = false;
+	HXVector<HXCompositeTile, HXMemoryTag::Painter> Tiles;
+	HXTaskGroup                                     Composite;
+
+	// All windows alive across frames, keyed by their identities, the
+	// windows not submitted for a while will be released in HX::End
+	HXHashMap<HXID, HXWindow *, HXMemoryTag::Window> WindowPool;
+	uint64_t                                        Frame = 0;
+
+	// The identities the labels are nested in, the bottom one is the
+	// current window
+	HXVector<HXID, HXMemoryTag::Layout> IDStack;
+
+	// The scroll regions of the current window opened by HX::BeginScroll
+	// and not closed yet, the innermost one is the last
+	HXVector<HXScrollRegion, HXMemoryTag::Layout> ScrollStack;
+
+	// The layouts of the current window opened and not closed yet, with the
+	// cells of all of them, the innermost layout is the last
+	HXVector<HXLayoutFrame, HXMemoryTag::Layout> LayoutStack;
+	HXVector<HXLayoutTrack, HXMemoryTag::Layout> LayoutTracks;
+
+	// The states of the widgets created without a profile, the states not
+	// seen for a while are released in HX::End
+	HXStateTable<HX::ButtonProfile> ButtonStates;
+	HXStateTable<HX::WindowProfile> WindowStates;
+	HXStateTable<HX::ScrollProfile> ScrollStates;
+
+	// The cells of the layouts solved by the earlier frames
+	HXStateTable<HXLayoutCache> LayoutStates;
+
+	// The painter for the LocalBuffer, which is only recreated when the
+	// buffer changes
+	HXBufferPainter *TargetPainter = nullptr;
+	void *           TargetBuffer  = nullptr;
+
+	// The damaged regions of the target accumulated since the last
+	// HX::Render, and the windows composited by it in z-order
+	HXVector<HXRect, HXMemoryTag::Painter>    DirtyRects;
+	HXVector<HXWindow *, HXMemoryTag::Window> PresentedWindows;
+	bool                                      FullDamage = true;
+
+	// The measurements of the texts, kept across frames
+	HXMeasureCache MeasureCache;
+
+	// The memory of the data living in a single frame, reset by HX::Begin
+	HXFrameArena FrameArena;
+
+	// The spans and the counters of the frames
+	HXProfiler Profiler;
+
+	// The allocations counted since HX::Begin, and the guard flagging the
+	// frames allocating once the frames have stopped allocating
+	HXMemoryStats     FrameMemoryStart;
+	HXMemoryStats     FrameMemory;
+	HXAllocationGuard AllocationGuard      = HXAllocationGuard::Off;
+	bool              MemorySteady         = false;
+	uint64_t          GuardedAtBegin       = 0;
+	uint64_t          AllocationViolations = 0;
+
+	// The allocations flagged on the pool threads running the tasks of a
+	// guarded frame
+	std::atomic<uint64_t> TaskGuarded = 0;
+
+	// The messages pushed but not drained into the message query yet, the
+	// count of the messages dropped by a full input queue is kept apart
+	// since it is written by the input thread
+	HXSpscQueue<HXMessage, 1024> InputQueue;
+	std::atomic<uint64_t>        InputDropped = 0;
+
+	// Whether the last frame handled input or changed the target, and when
+	// the frame requested by HX::RequestFrame is due
+	bool                                  Active        = true;
+	std::chrono::steady_clock::time_point FrameDeadline = std::chrono::steady_clock::time_point::max();
+
+	// The UI thread sleeping in HX::WaitForEvents, which is woken by the
+	// thread pushing a message
+	std::atomic<bool>       Sleeping = false;
+	std::mutex              WakeLock;
+	std::condition_variable WakeSignal;
+
+	// The hit-test index of the windows built in HX::End from top to bottom,
+	// with the count of the messages routed in this frame and the index of
+	// the last mouse message
+	HXHitGrid                                 WindowGrid;
+	HXVector<HXWindow *, HXMemoryTag::Window> HitWindows;
+	size_t                                    RoutedMessages   = 0;
+	uint32_t                                  LastMouseMessage = HXNoMessage;
+
+	HX_TAGGED_NEW(HXMemoryTag::General)
+
+	~HXRuntimeContext();
 };
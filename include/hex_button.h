@@ -27,6 +27,7 @@
  
 #pragma once
 
+#include <include/hex_id.h>
 #include <include/hex_string.h>
 #include <include/impl/hex_impl.h>
 
@@ -49,5 +50,14 @@ struct ButtonProfile {
  * @param Profile The profile of the button
  * @return If the button was pressed, returning true, nor returning false
  */
-bool Button(const HXString &Title, ButtonProfile &Profile);
+bool Button(HXStringView Title, ButtonProfile &Profile);
+
+/**
+ * Creating a button whose state is kept by the context, the button is
+ * identified by its title nested in the identity stack, a title written as
+ * a string literal is hashed at compile time
+ * @param Title The title of the button
+ * @return If the button was pressed, returning true, nor returning false
+ */
+bool Button(HXTitle Title);
 }
\ No newline at end of file
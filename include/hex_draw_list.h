@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * \file hex_draw_list.h
+ * \brief The recorded draw commands of a window
+ */
+
+#pragma once
+
+#include <include/hex_hash.h>
+#include <include/hex_memory.h>
+#include <include/hex_string.h>
+#include <include/impl/hex_impl.h>
+
+#include <vector>
+
+/**
+ * The type of a draw command
+ */
+enum class HXDrawCommandType : uint8_t {
+	Clear,
+	Line,
+	Rectangle,
+	FilledRectangle,
+	FilledRoundedRectangle,
+	FilledPolygon,
+	Text,
+	Clip
+};
+
+/**
+ * A recorded draw command, the variable length data like the points of a
+ * polygon or the characters of a text are kept in the payload of the list
+ */
+struct HXDrawCommand {
+	HXDrawCommandType Type      = HXDrawCommandType::Clear;
+	HXColor           Color     = {};
+	HXColor           FillColor = {};
+
+	// The rectangle of the command, a line stores its two points as the
+	// (Left, Top) and (Right, Bottom) corners, a text stores where to draw
+	// it in the (Left, Top) corner, a clip stores the clip rectangle
+	HXRect Rect = {0, 0, 0, 0};
+
+	// The radius of a rounded rectangle or the height of a text
+	HXGInt Extra = 0;
+
+	// The range of the command in the payload of the list
+	uint32_t Offset = 0;
+	uint32_t Count  = 0;
+
+	// The index of the font of a text in the list
+	uint32_t Font = 0;
+};
+
+/**
+ * The list of draw commands recorded by a window during the layout, the
+ * list will be replayed onto the painter of the window in one pass in
+ * HX::Render. The storage is rewound instead of being freed every frame,
+ * so a list reaching its steady size does not allocate anymore
+ */
+class HXDrawList {
+public:
+	/**
+	 * Dropping all recorded commands while keeping the storage
+	 */
+	void Reset();
+
+	/**
+	 * Getting the count of the recorded commands
+	 * @return The count of the commands
+	 */
+	size_t Size() const;
+
+	/**
+	 * Getting the hash of everything recorded, which is accumulated while
+	 * recording, two lists with the same hash produce the same output
+	 * @return The hash of the recorded commands
+	 */
+	HXHash Hash() const;
+
+	/**
+	 * Replaying all recorded commands onto a painter, the clip rectangle of
+	 * the painter is removed once the list is replayed
+	 * @param Painter The painter to be drawn on
+	 */
+	void Replay(HXBufferPainter *Painter) const;
+
+public:
+	void AddClear(HXColor Color);
+
+	void AddLine(HXPoint Point1, HXPoint Point2, HXColor Color);
+
+	void AddRectangle(HXRect Rect, HXColor Color);
+
+	void AddFilledRectangle(HXRect Rect, HXColor Color, HXColor FillColor);
+
+	void AddFilledRoundedRectangle(HXRect Rect, HXColor Color, HXColor FillColor, HXGInt Radius);
+
+	void AddFilledPolygon(const HXPoint *Points, size_t Count, HXColor Color);
+
+	void AddText(HXStringView Text, HXFontHandle Font, HXPoint Where, HXColor Color, HXGUInt Height);
+
+	/**
+	 * Limiting the commands recorded after this one to a rectangle
+	 * @param Rect The rectangle to draw in, the right and the bottom edges
+	 * are exclusive
+	 */
+	void AddClipRect(HXRect Rect);
+
+private:
+	HXVector<HXDrawCommand, HXMemoryTag::DrawList> _commands;
+	HXVector<HXPoint, HXMemoryTag::DrawList>       _points;
+	HXVector<HXFontHandle, HXMemoryTag::DrawList>  _fonts;
+	HXTaggedString<HXMemoryTag::DrawList>          _text;
+	HXHash                                         _hash = HXHashSeed;
+
+private:
+	void HashCommand(const HXDrawCommand &Command);
+};
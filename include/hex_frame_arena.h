@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_frame_arena.h
+ * \brief The bump allocator for the data living in a single frame
+ */
+
+#pragma once
+
+#include <include/hex_memory.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * The counters of a frame arena
+ */
+struct HXFrameArenaStats {
+	// The bytes handed out since the last reset, and the most of them in
+	// any frame
+	size_t Used = 0;
+	size_t Peak = 0;
+
+	// The bytes held by the blocks of the arena, and the count of the times
+	// a new block had to be allocated
+	size_t   Capacity    = 0;
+	uint64_t BlockAllocs = 0;
+};
+
+/**
+ * The bump allocator for the transient data of a frame, an allocation only
+ * advances an offset in a block and nothing is freed until the arena is
+ * reset. When a frame needs more than one block, the blocks are merged into
+ * a single one by the next reset, so the arena stops allocating once the
+ * frames reach their steady size
+ */
+class HXFrameArena {
+public:
+	/**
+	 * Constructing the arena, no memory is allocated until the first use
+	 * @param BlockSize The size of the blocks allocated by the arena
+	 */
+	explicit HXFrameArena(size_t BlockSize = 64 * 1024);
+
+	HXFrameArena(const HXFrameArena &) = delete;
+
+	HXFrameArena &operator=(const HXFrameArena &) = delete;
+
+public:
+	/**
+	 * Allocating raw memory which is valid until the next reset
+	 * @param Size The count of the bytes
+	 * @param Alignment The alignment of the memory, which must be a power
+	 * of two
+	 * @return The allocated memory
+	 */
+	void *Allocate(size_t Size, size_t Alignment = alignof(std::max_align_t));
+
+	/**
+	 * Allocating an array of value initialized elements, the elements are
+	 * never destructed so they must be trivially destructible
+	 * @param Count The count of the elements
+	 * @return The first element of the array
+	 */
+	template<class Type>
+	Type *Allocate(size_t Count) {
+		static_assert(std::is_trivially_destructible_v<Type>, "The arena never destructs its elements");
+
+		auto elements = static_cast<Type *>(Allocate(sizeof(Type) * Count, alignof(Type)));
+		for (size_t index = 0; index < Count; ++index) {
+			new (elements + index) Type();
+		}
+
+		return elements;
+	}
+
+	/**
+	 * Releasing everything allocated at once, the memory is kept for the
+	 * next frame
+	 */
+	void Reset();
+
+	/**
+	 * Getting the counters of the arena
+	 * @return The counters of the arena
+	 */
+	const HXFrameArenaStats &Stats() const;
+
+private:
+	struct Block {
+		HXTaggedArray<std::byte, HXMemoryTag::Arena> Memory;
+		size_t                                       Size;
+	};
+
+	HXVector<Block, HXMemoryTag::Arena> _blocks;
+	size_t                              _blockSize;
+	size_t                              _current = 0;
+	size_t                              _offset  = 0;
+	HXFrameArenaStats                   _stats;
+};
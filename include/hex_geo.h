@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 
 using HXGInt  = int32_t;
@@ -49,4 +50,25 @@ struct HXRect {
 	HXGInt CalHeight() const {
 		return Bottom - Top;
 	}
+
+	/**
+	 * Checking whether the rectangle covers no area, the right and the
+	 * bottom edges are treated as exclusive
+	 */
+	bool IsEmpty() const {
+		return Right <= Left || Bottom <= Top;
+	}
+	bool Overlaps(const HXRect &Other) const {
+		return Left < Other.Right && Other.Left < Right && Top < Other.Bottom && Other.Top < Bottom;
+	}
+	HXRect Intersect(const HXRect &Other) const {
+		return {std::max(Left, Other.Left), std::max(Top, Other.Top), std::min(Right, Other.Right),
+		        std::min(Bottom, Other.Bottom)};
+	}
+	HXRect Union(const HXRect &Other) const {
+		return {std::min(Left, Other.Left), std::min(Top, Other.Top), std::max(Right, Other.Right),
+		        std::max(Bottom, Other.Bottom)};
+	}
+
+	bool operator==(const HXRect &) const = default;
 };
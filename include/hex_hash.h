@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * \file hex_hash.h
+ * \brief The hashing helpers
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+using HXHash = uint64_t;
+
+/**
+ * The initial value of a hash, which is the FNV-1a offset basis
+ */
+constexpr HXHash HXHashSeed = 14695981039346656037ull;
+
+/**
+ * Combining a value into a hash
+ * @param Hash The hash to be combined into
+ * @param Value The value to be combined
+ * @return The combined hash
+ */
+constexpr HXHash HXHashCombine(HXHash Hash, uint64_t Value) {
+	return Hash ^ (Value + 0x9E3779B97F4A7C15ull + (Hash << 6) + (Hash >> 2));
+}
+
+/**
+ * Hashing a string with FNV-1a
+ * @param Text The characters of the string
+ * @param Length The count of the characters
+ * @param Hash The hash to be continued
+ * @return The hash of the string
+ */
+template <class Character>
+constexpr HXHash HXHashString(const Character *Text, size_t Length, HXHash Hash = HXHashSeed) {
+	for (size_t index = 0; index < Length; ++index) {
+		Hash ^= static_cast<uint64_t>(Text[index]);
+		Hash *= 1099511628211ull;
+	}
+
+	return Hash;
+}
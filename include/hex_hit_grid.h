@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_hit_grid.h
+ * \brief The spatial index for hit-testing
+ */
+
+#pragma once
+
+#include <include/hex_geo.h>
+#include <include/hex_memory.h>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * A uniform grid over the rectangles to be hit-tested, every cell lists the
+ * rectangles overlapping it in the order they were inserted, so finding the
+ * rectangle under a point only tests the few rectangles of a single cell.
+ * The rectangles are inclusive on all edges like the controls drawing them
+ */
+class HXHitGrid {
+public:
+	static constexpr uint32_t NoHit = UINT32_MAX;
+
+public:
+	/**
+	 * Dropping all rectangles while keeping the storage
+	 */
+	void Reset();
+
+	/**
+	 * Inserting a rectangle, which takes effect after HXHitGrid::Build
+	 * @param Rect The rectangle to be hit-tested
+	 * @param Value The value returned when the rectangle is hit
+	 */
+	void Insert(HXRect Rect, uint32_t Value);
+
+	/**
+	 * Building the cells from the inserted rectangles
+	 */
+	void Build();
+
+	/**
+	 * Finding the first inserted rectangle containing a point
+	 * @param Point The point to be tested
+	 * @return The value of the rectangle hit, or NoHit if nothing is hit
+	 */
+	uint32_t Find(HXPoint Point) const;
+
+private:
+	// The grid covers the bounds with at most MaxCells cells on each side,
+	// the cells grow beyond MinCellSize when the bounds are too large
+	static constexpr HXGInt MinCellSize = 64;
+	static constexpr HXGInt MaxCells    = 64;
+
+	struct Entry {
+		HXRect   Rect;
+		uint32_t Value;
+	};
+
+	HXVector<Entry, HXMemoryTag::Layout>    _entries;
+	HXVector<uint32_t, HXMemoryTag::Layout> _cellStart;
+	HXVector<uint32_t, HXMemoryTag::Layout> _cellEntries;
+	HXVector<uint32_t, HXMemoryTag::Layout> _cellFill;
+
+	HXRect _bounds   = {0, 0, 0, 0};
+	HXGInt _cellSize = MinCellSize;
+	HXGInt _columns  = 0;
+	HXGInt _rows     = 0;
+};
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_id.h
+ * \brief The identities of the widgets
+ */
+
+#pragma once
+
+#include <include/hex_hash.h>
+#include <include/hex_string.h>
+
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * The identity of a widget, which is the hash of its label combined with
+ * the identities it is nested in
+ */
+using HXID = HXHash;
+
+/**
+ * The identity no widget has, which marks the empty slots of the tables
+ */
+constexpr HXID HXNoID = 0;
+
+/**
+ * Getting the count of the characters of a string, which ends at the first
+ * terminating character or at the end of its storage
+ * @param Text The characters of the string
+ * @param Capacity The count of the characters stored
+ * @return The count of the characters of the string
+ */
+template<class Character>
+constexpr size_t HXLabelLength(const Character *Text, size_t Capacity = SIZE_MAX) {
+	size_t length = 0;
+	while (length < Capacity && Text[length] != Character{}) {
+		++length;
+	}
+
+	return length;
+}
+
+/**
+ * A label hashed once it is constructed, the labels written as string
+ * literals are hashed at compile time, while the pointers and the arrays
+ * holding runtime text are hashed when the label is made. Either is hashed
+ * up to its terminating character or the end of its storage. The
+ * characters are hashed by their values, so a narrow and a wide literal of
+ * the same ASCII text give the same hash
+ */
+struct HXLabel {
+	HXHash Hash;
+
+	template<class Character, size_t Length>
+	constexpr HXLabel(const Character (&Text)[Length]) : Hash(HXHashString(Text, HXLabelLength(Text, Length))) {
+	}
+
+	// The pointer is taken by reference, so an array never decays into it
+	template<class Pointer>
+		requires std::is_pointer_v<Pointer> && std::is_integral_v<std::remove_pointer_t<Pointer>>
+	HXLabel(const Pointer &Text) : Hash(HXHashString(Text, HXLabelLength(Text))) {
+	}
+
+	HXLabel(HXStringView Text) : Hash(HXHashString(Text.data(), Text.size())) {
+	}
+
+	HXLabel(const HXString &Text) : HXLabel(HXStringView(Text)) {
+	}
+};
+
+/**
+ * A label shown as the title of a widget, which keeps the text of the
+ * label besides its hash. A title written as a string literal is hashed at
+ * compile time like a HXLabel
+ */
+struct HXTitle : HXLabel {
+	HXStringView Text;
+
+	template<size_t Length>
+	constexpr HXTitle(const HXString::value_type (&Title)[Length])
+		: HXLabel(Title), Text(Title, HXLabelLength(Title, Length)) {
+	}
+
+	template<class Pointer>
+		requires std::is_same_v<std::remove_const_t<std::remove_pointer_t<Pointer>>, HXString::value_type> &&
+		         std::is_pointer_v<Pointer>
+	HXTitle(const Pointer &Title) : HXTitle(HXStringView(Title)) {
+	}
+
+	HXTitle(HXStringView Title) : HXLabel(Title), Text(Title) {
+	}
+
+	HXTitle(const HXString &Title) : HXTitle(HXStringView(Title)) {
+	}
+};
+
+/**
+ * Making the identity of a label nested in another identity
+ * @param Parent The identity the label is nested in
+ * @param Label The label of the widget
+ * @return The identity of the widget, which is never HXNoID
+ */
+constexpr HXID HXMakeID(HXID Parent, HXLabel Label) {
+	const HXID id = HXHashCombine(Parent, Label.Hash);
+
+	return id != HXNoID ? id : 1;
+}
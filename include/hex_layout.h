@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_layout.h
+ * \brief The layout of the widgets for HiEasyX
+ */
+
+#pragma once
+
+#include <include/hex_hash.h>
+#include <include/hex_id.h>
+#include <include/hex_memory.h>
+#include <include/impl/hex_impl.h>
+
+#include <initializer_list>
+#include <span>
+
+namespace HX {
+/**
+ * How a cell of a layout is sized along the axis of the layout
+ */
+enum class SizeMode : uint8_t {
+	// The size of the content of the cell, as measured by the last frame
+	Auto,
+	// A size in pixels
+	Fixed,
+	// A share of the space left by the other cells, in proportion to the
+	// weight of the cell
+	Flex
+};
+
+/**
+ * The size of a cell of a layout
+ */
+struct LayoutSize {
+	SizeMode Mode  = SizeMode::Auto;
+	HXGInt   Value = 0;
+};
+
+/**
+ * A cell sized by its content
+ */
+constexpr LayoutSize Auto() {
+	return {.Mode = SizeMode::Auto, .Value = 0};
+}
+
+/**
+ * A cell of a fixed size
+ * @param Pixels The size of the cell
+ */
+constexpr LayoutSize Fixed(HXGInt Pixels) {
+	return {.Mode = SizeMode::Fixed, .Value = Pixels};
+}
+
+/**
+ * A cell sharing the space left by the other cells
+ * @param Weight The weight of the cell among the flexible cells
+ */
+constexpr LayoutSize Flex(HXGInt Weight = 1) {
+	return {.Mode = SizeMode::Flex, .Value = Weight};
+}
+
+/**
+ * Opening a horizontal stack, the widgets created until HX::EndLayout take
+ * the cells from left to right. When there are more widgets than cells the
+ * widgets wrap onto a new line, so the stack lays out a grid. A stack
+ * without cells places the widgets side by side by their own widths. The
+ * sizes of the cells are solved once and cached with the identity of the
+ * stack, they are only solved again when the width given to the stack, the
+ * cells or the content of the auto cells change
+ * @param Label The label of the stack, the identities of the widgets in the
+ * stack are nested in it
+ * @param Cells The widths of the cells
+ * @param Gap The gap between the cells and between the lines
+ */
+void BeginRow(HXLabel Label, std::span<const LayoutSize> Cells, HXGInt Gap = 5);
+
+void BeginRow(HXLabel Label, std::initializer_list<LayoutSize> Cells, HXGInt Gap = 5);
+
+/**
+ * Opening a vertical stack, the widgets created until HX::EndLayout are
+ * placed from top to bottom and take the cells in order, the widgets after
+ * the last cell are sized by their content. The flexible cells share the
+ * height given to the stack, which is the rest of the window for a stack
+ * opened in the window or the size of the cell the stack is opened in
+ * @param Label The label of the stack, the identities of the widgets in the
+ * stack are nested in it
+ * @param Cells The heights of the cells
+ * @param Gap The gap between the cells
+ */
+void BeginColumn(HXLabel Label, std::span<const LayoutSize> Cells = {}, HXGInt Gap = 5);
+
+void BeginColumn(HXLabel Label, std::initializer_list<LayoutSize> Cells, HXGInt Gap = 5);
+
+/**
+ * Opening a grid of the columns of the same size, which is a horizontal
+ * stack repeating a cell
+ * @param Label The label of the grid, the identities of the widgets in the
+ * grid are nested in it
+ * @param Columns The count of the columns
+ * @param Column The width of every column
+ * @param Gap The gap between the columns and between the lines
+ */
+void BeginGrid(HXLabel Label, size_t Columns, LayoutSize Column = Flex(), HXGInt Gap = 5);
+
+/**
+ * Closing the stack opened by the last HX::BeginRow, HX::BeginColumn or
+ * HX::BeginGrid, the stack is placed in its parent as a single widget
+ */
+void EndLayout();
+
+/**
+ * Getting the space the next widget of the current window can take, which
+ * is the next cell of the open stack or the width of the window below the
+ * last widget. The space is not taken until HX::PlaceControl
+ * @return The space relative to the window, a bottom not below the top
+ * means the height is not limited
+ */
+HXRect AvailableRect();
+
+/**
+ * Taking the space of the next widget of the current window, the widget is
+ * stretched to the cell it takes when the cell has a fixed or a flexible size
+ * @param Size The size the widget wants
+ * @return The rectangle of the widget relative to the window
+ */
+HXRect PlaceControl(HXPoint Size);
+
+/**
+ * Opening a vertical stack in a given rectangle without caching anything,
+ * for the widgets hosting other widgets like the scroll regions
+ * @param Bounds The rectangle relative to the window, a bottom not below the
+ * top means the height is not limited
+ * @param Gap The gap between the widgets
+ */
+void OpenLayout(HXRect Bounds, HXGInt Gap = 5);
+
+/**
+ * Closing the stack opened by the last HX::OpenLayout without placing it in
+ * its parent
+ * @return The size of the content of the stack
+ */
+HXPoint CloseLayout();
+}
+
+/**
+ * The axis the widgets of a layout are placed along
+ */
+enum class HXLayoutAxis : uint8_t {
+	Horizontal,
+	Vertical
+};
+
+/**
+ * A cell of a layout solved along the axis of the layout
+ */
+struct HXLayoutTrack {
+	HXGInt       Offset = 0;
+	HXGInt       Size   = 0;
+	HX::SizeMode Mode   = HX::SizeMode::Auto;
+
+	// The largest content placed in the cell, which sizes the auto cells of
+	// the next frame
+	HXGInt Measured = 0;
+};
+
+/**
+ * The solved cells of a layout kept across frames, with the hash of the
+ * inputs they were solved from
+ */
+struct HXLayoutCache {
+	HXHash                                       Key = 0;
+	HXVector<HXLayoutTrack, HXMemoryTag::Layout> Tracks;
+};
+
+/**
+ * A layout opened in the current window, the cells of the layout are kept
+ * in the track stack of the context
+ */
+struct HXLayoutFrame {
+	// The identity of the cache of the layout, HXNoID for a layout opened
+	// by HX::OpenLayout
+	HXID         Id;
+	HXLayoutAxis Axis;
+	HXRect       Bounds;
+	HXGInt       Gap;
+
+	// The cells of the layout in the track stack, and the count of the
+	// widgets placed
+	size_t First;
+	size_t Count;
+	size_t Cell = 0;
+
+	// The line of a horizontal layout being filled, where the next widget
+	// of a layout without cells goes and how far the widgets reach
+	HXGInt LineTop;
+	HXGInt LineBottom;
+	HXGInt Cursor;
+	HXGInt Right;
+};
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_list_clipper.h
+ * \brief The clipper of the long lists for HiEasyX
+ */
+
+#pragma once
+
+#include <include/hex_memory.h>
+#include <include/impl/hex_impl.h>
+
+#include <type_traits>
+
+namespace HX {
+/**
+ * The callback laying out an item of a clipped list
+ */
+using ListItem = void (*)(size_t Index, void *User);
+
+/**
+ * The heights of the items of a list whose items differ in height. The
+ * height of an item is learned when the item is laid out, the items never
+ * laid out are assumed to be of the estimated height. The offsets of the
+ * items are kept as prefix sums, so the height of the items skipped is
+ * found in constant time and the first visible item by a binary search
+ */
+class ListHeights {
+public:
+	/**
+	 * Constructing the heights of an empty list
+	 * @param EstimatedHeight The height assumed for the items never laid out
+	 */
+	explicit ListHeights(HXGInt EstimatedHeight = 23);
+
+public:
+	/**
+	 * Changing the count of the items, the items added are of the estimated
+	 * height and the learned heights of the items kept are kept
+	 * @param Count The count of the items
+	 */
+	void Resize(size_t Count);
+
+	/**
+	 * Getting the count of the items
+	 * @return The count of the items
+	 */
+	size_t Size() const;
+
+	/**
+	 * Setting the height of an item, the offsets after it are updated lazily
+	 * @param Index The index of the item
+	 * @param Height The height of the item including the gap after it
+	 */
+	void Set(size_t Index, HXGInt Height);
+
+	/**
+	 * Getting the offset of an item from the top of the list
+	 * @param Index The index of the item, the count of the items gives the
+	 * height of the whole list
+	 * @return The offset of the top of the item
+	 */
+	int64_t Offset(size_t Index);
+
+	/**
+	 * Finding the item covering an offset from the top of the list
+	 * @param Offset The offset from the top of the list
+	 * @return The index of the item, clamped into the list
+	 */
+	size_t Find(int64_t Offset);
+
+private:
+	void Update();
+
+private:
+	HXVector<HXGInt, HXMemoryTag::Layout>  _heights;
+	HXVector<int64_t, HXMemoryTag::Layout> _offsets;
+	size_t                                 _dirty = 0;
+	HXGInt                                 _estimated;
+};
+
+/**
+ * Laying out a list of items of the same height in the current window, only
+ * the items visible in the window are laid out while the base line skips
+ * over the others at once, so the cost does not depend on the count of the
+ * items. The base line ends below the whole list
+ * @param Count The count of the items
+ * @param ItemHeight The height of an item including the gap after it, when
+ * it is not positive the first item is always laid out and measured
+ * @param Item The callback laying out an item at the base line
+ * @param User The pointer passed to the callback
+ */
+void ClipList(size_t Count, HXGInt ItemHeight, ListItem Item, void *User);
+
+/**
+ * Laying out a list of items of different heights in the current window,
+ * only the items visible in the window are laid out and their heights are
+ * learned into the heights, the base line ends below the whole list
+ * @param Heights The heights of the items, whose size is the count of the
+ * items
+ * @param Item The callback laying out an item at the base line
+ * @param User The pointer passed to the callback
+ */
+void ClipList(ListHeights &Heights, ListItem Item, void *User);
+
+/**
+ * Laying out a list of items of the same height with a callable
+ * @param Count The count of the items
+ * @param ItemHeight The height of an item including the gap after it
+ * @param Item The callable taking the index of the item to be laid out
+ */
+template<class Function>
+void ClipList(size_t Count, HXGInt ItemHeight, Function &&Item) {
+	ClipList(Count, ItemHeight, [](size_t Index, void *User) {
+		(*static_cast<std::remove_reference_t<Function> *>(User))(Index);
+	}, static_cast<void *>(&Item));
+}
+
+/**
+ * Laying out a list of items of different heights with a callable
+ * @param Heights The heights of the items
+ * @param Item The callable taking the index of the item to be laid out
+ */
+template<class Function>
+void ClipList(ListHeights &Heights, Function &&Item) {
+	ClipList(Heights, [](size_t Index, void *User) {
+		(*static_cast<std::remove_reference_t<Function> *>(User))(Index);
+	}, static_cast<void *>(&Item));
+}
+}
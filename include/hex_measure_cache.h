@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * \file hex_measure_cache.h
+ * \brief The cache of text measurements
+ */
+
+#pragma once
+
+#include <include/hex_hash.h>
+#include <include/hex_memory.h>
+#include <include/hex_string.h>
+#include <include/impl/hex_impl.h>
+
+#include <vector>
+
+/**
+ * The counters of a measurement cache
+ */
+struct HXMeasureCacheStats {
+	uint64_t Hits      = 0;
+	uint64_t Misses    = 0;
+	uint64_t Evictions = 0;
+};
+
+/**
+ * The bounded cache of the text measurements. The cache is a direct mapped
+ * table, so a lookup is a single probe and the memory never grows beyond
+ * the capacity. An entry is identified by the 64 bits hash of the text, the
+ * font and the height together with the length of the text, the text itself
+ * is not stored
+ */
+class HXMeasureCache {
+public:
+	/**
+	 * Constructing the cache
+	 * @param Capacity The count of the entries, rounded up to a power of two
+	 */
+	explicit HXMeasureCache(size_t Capacity = 4096);
+
+public:
+	/**
+	 * Measuring a text through the cache, the painter is only asked when
+	 * the measurement is not cached
+	 * @param Painter The painter to measure the text with
+	 * @param Text The text to be measured
+	 * @param Font The font using to measure
+	 * @param Height The height of the font
+	 * @return The rectangle of the text measured
+	 */
+	HXRect Measure(HXBufferPainter *Painter, HXStringView Text, HXFontHandle Font, HXGUInt Height);
+
+	/**
+	 * Dropping all cached measurements, which is needed when the measuring
+	 * backend changes
+	 */
+	void Clear();
+
+	/**
+	 * Getting the counters of the cache
+	 * @return The counters of the cache
+	 */
+	const HXMeasureCacheStats &Stats() const;
+
+private:
+	struct Entry {
+		HXHash Key    = 0;
+		size_t Length = 0;
+		HXRect Result = {0, 0, 0, 0};
+		bool   Used   = false;
+	};
+
+	HXVector<Entry, HXMemoryTag::Text> _entries;
+	size_t                             _mask;
+	HXMeasureCacheStats                _stats;
+};
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_memory.h
+ * \brief The counted allocation hooks of HiEasyX
+ */
+
+#pragma once
+
+#include <include/hex_string.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The subsystem an allocation is made for, the allocations are counted per
+ * tag
+ */
+enum class HXMemoryTag : uint8_t {
+	General,
+	Window,
+	Painter,
+	DrawList,
+	Input,
+	Layout,
+	Arena,
+	Text,
+	Count
+};
+
+/**
+ * Getting the printable name of a tag
+ * @param Tag The tag
+ * @return The name of the tag
+ */
+const char *HXMemoryTagName(HXMemoryTag Tag);
+
+/**
+ * The functions the library allocates its memory with, the user pointer is
+ * passed back to them untouched. The size, the alignment and the tag passed
+ * to the free function are the ones passed to the allocation
+ */
+struct HXMemoryHooks {
+	void *(*Allocate)(size_t Size, size_t Alignment, HXMemoryTag Tag, void *User) = nullptr;
+	void (*Free)(void *Memory, size_t Size, size_t Alignment, HXMemoryTag Tag, void *User) = nullptr;
+
+	void *User = nullptr;
+};
+
+/**
+ * Setting the functions the library allocates with, which must happen
+ * before anything is allocated since the memory is given back to the hooks
+ * it came from. Passing empty hooks restores the global operator new
+ * @param Hooks The allocation functions
+ */
+void HXSetMemoryHooks(const HXMemoryHooks &Hooks);
+
+/**
+ * The counters of the allocations of a tag
+ */
+struct HXMemoryCounter {
+	uint64_t Allocations = 0;
+	uint64_t Frees       = 0;
+	uint64_t Bytes       = 0;
+	uint64_t FreedBytes  = 0;
+};
+
+/**
+ * The counters of the allocations of every tag
+ */
+struct HXMemoryStats {
+	HXMemoryCounter Tags[static_cast<size_t>(HXMemoryTag::Count)];
+
+	/**
+	 * Getting the counters of a tag
+	 * @param Tag The tag
+	 * @return The counters of the tag
+	 */
+	const HXMemoryCounter &operator[](HXMemoryTag Tag) const {
+		return Tags[static_cast<size_t>(Tag)];
+	}
+
+	/**
+	 * Summing the counters of all the tags
+	 * @return The sum of the counters
+	 */
+	HXMemoryCounter Total() const;
+
+	/**
+	 * Getting the counters accumulated since an earlier snapshot
+	 * @param Since The earlier snapshot
+	 * @return The difference between the snapshots
+	 */
+	HXMemoryStats Delta(const HXMemoryStats &Since) const;
+};
+
+/**
+ * Taking a snapshot of the counters of the whole process, the counters are
+ * shared by every context and every thread
+ * @return The counters of every tag
+ */
+HXMemoryStats HXGetMemoryStats();
+
+/**
+ * Allocating memory through the hooks and counting it
+ * @param Size The count of the bytes
+ * @param Alignment The alignment of the memory
+ * @param Tag The subsystem allocating
+ * @return The allocated memory, std::bad_alloc is thrown on failure
+ */
+void *HXAllocate(size_t Size, size_t Alignment, HXMemoryTag Tag);
+
+/**
+ * Freeing memory allocated by HXAllocate
+ * @param Memory The memory, nothing is done for nullptr
+ * @param Size The size passed to HXAllocate
+ * @param Alignment The alignment passed to HXAllocate
+ * @param Tag The tag passed to HXAllocate
+ */
+void HXFree(void *Memory, size_t Size, size_t Alignment, HXMemoryTag Tag);
+
+/**
+ * What the allocation guard does with an allocation made while it is armed
+ */
+enum class HXAllocationGuard : uint8_t {
+	Off,
+	Report,
+	Abort
+};
+
+/**
+ * Arming the guard flagging every allocation the calling thread makes
+ * through the hooks until it is disarmed, the other threads are unaffected.
+ * A reported allocation is only counted while an aborting one stops the
+ * process right where it allocates, so the debugger shows who allocated
+ * @param Mode The action of the guard, HXAllocationGuard::Off disarms it
+ * @return The action of the guard before it was armed
+ */
+HXAllocationGuard HXArmAllocationGuard(HXAllocationGuard Mode);
+
+/**
+ * Getting the count of the allocations made while the guard was armed
+ * @return The count of the guarded allocations of the calling thread
+ */
+uint64_t HXGuardedAllocations();
+
+/**
+ * The standard allocator routing the allocations of a container through
+ * the hooks under a tag
+ */
+template<class Type, HXMemoryTag Tag>
+class HXTaggedAllocator {
+public:
+	using value_type = Type;
+
+	template<class Other>
+	struct rebind {
+		using other = HXTaggedAllocator<Other, Tag>;
+	};
+
+	HXTaggedAllocator() noexcept = default;
+
+	template<class Other>
+	HXTaggedAllocator(const HXTaggedAllocator<Other, Tag> &) noexcept {
+	}
+
+public:
+	Type *allocate(size_t Count) {
+		return static_cast<Type *>(HXAllocate(sizeof(Type) * Count, alignof(Type), Tag));
+	}
+
+	void deallocate(Type *Memory, size_t Count) noexcept {
+		HXFree(Memory, sizeof(Type) * Count, alignof(Type), Tag);
+	}
+
+	template<class Other>
+	bool operator==(const HXTaggedAllocator<Other, Tag> &) const noexcept {
+		return true;
+	}
+};
+
+template<class Type, HXMemoryTag Tag = HXMemoryTag::General>
+using HXVector = std::vector<Type, HXTaggedAllocator<Type, Tag>>;
+
+template<class Key, class Value, HXMemoryTag Tag = HXMemoryTag::General, class Hasher = std::hash<Key>>
+using HXHashMap = std::unordered_map<Key, Value, Hasher, std::equal_to<Key>,
+                                     HXTaggedAllocator<std::pair<const Key, Value>, Tag>>;
+
+template<HXMemoryTag Tag = HXMemoryTag::General>
+using HXTaggedString = std::basic_string<HXString::value_type, std::char_traits<HXString::value_type>,
+                                         HXTaggedAllocator<HXString::value_type, Tag>>;
+
+/**
+ * The deleter of the arrays allocated by HXAllocateArray
+ */
+template<HXMemoryTag Tag>
+struct HXTaggedDeleter {
+	size_t Size      = 0;
+	size_t Alignment = alignof(std::max_align_t);
+
+	void operator()(void *Memory) const noexcept {
+		HXFree(Memory, Size, Alignment, Tag);
+	}
+};
+
+template<class Type, HXMemoryTag Tag>
+using HXTaggedArray = std::unique_ptr<Type[], HXTaggedDeleter<Tag>>;
+
+/**
+ * Allocating an uninitialized array of trivial elements through the hooks
+ * @param Count The count of the elements
+ * @return The array owning the memory
+ */
+template<class Type, HXMemoryTag Tag>
+HXTaggedArray<Type, Tag> HXAllocateArray(size_t Count) {
+	static_assert(std::is_trivially_destructible_v<Type>, "The elements of the array are never destructed");
+
+	const size_t size = sizeof(Type) * Count;
+
+	return HXTaggedArray<Type, Tag>(static_cast<Type *>(HXAllocate(size, alignof(Type), Tag)),
+	                                HXTaggedDeleter<Tag>{.Size = size, .Alignment = alignof(Type)});
+}
+
+/**
+ * Routing the new and delete of a class through the hooks under a tag, it
+ * is placed in the body of the class. The over-aligned classes are given
+ * their own alignment
+ */
+#define HX_TAGGED_NEW(Tag)                                                                                             \
+	static void *operator new(size_t Size) {                                                                           \
+		return HXAllocate(Size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, Tag);                                                \
+	}                                                                                                                  \
+	static void *operator new(size_t Size, std::align_val_t Alignment) {                                               \
+		return HXAllocate(Size, static_cast<size_t>(Alignment), Tag);                                                  \
+	}                                                                                                                  \
+	static void operator delete(void *Memory, size_t Size) noexcept {                                                  \
+		HXFree(Memory, Size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, Tag);                                                   \
+	}                                                                                                                  \
+	static void operator delete(void *Memory, size_t Size, std::align_val_t Alignment) noexcept {                      \
+		HXFree(Memory, Size, static_cast<size_t>(Alignment), Tag);                                                     \
+	}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_message_queue.h
+ * \brief The queue of the messages pushed in a frame
+ */
+
+#pragma once
+
+#include <include/hex_memory.h>
+#include <include/impl/hex_impl.h>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * The counters of a message queue
+ */
+struct HXMessageQueueStats {
+	uint64_t Pushed  = 0;
+	uint64_t Merged  = 0;
+	uint64_t Dropped = 0;
+};
+
+/**
+ * The bounded queue of the messages pushed in a frame, which is a ring of a
+ * fixed capacity. A mouse move following another mouse move is merged into
+ * it, since only the latest position matters, the wheel messages in a row
+ * are merged by adding up their distances. When the queue is full, a move
+ * or a wheel arriving is dropped, while a button transition evicts the
+ * oldest pending move or grows the ring, since a lost release would leave
+ * the drags and the held buttons stuck. The messages are addressed by
+ * their order in the frame, starting from zero
+ */
+class HXMessageQueue {
+public:
+	/**
+	 * Constructing the queue
+	 * @param Capacity The count of the messages, rounded up to a power of two
+	 */
+	explicit HXMessageQueue(size_t Capacity = 256);
+
+public:
+	/**
+	 * Pushing a message to the queue
+	 * @param Message The message to be pushed
+	 */
+	void Push(const HXMessage &Message);
+
+	/**
+	 * Sealing all messages in the queue, the sealed messages will never be
+	 * merged with the later ones, which is needed once they are routed
+	 */
+	void Seal();
+
+	/**
+	 * Dropping all messages while keeping the counters
+	 */
+	void Clear();
+
+	/**
+	 * Getting the count of the messages in the queue
+	 * @return The count of the messages
+	 */
+	size_t Size() const;
+
+	HXMessage &operator[](size_t Index);
+
+	const HXMessage &operator[](size_t Index) const;
+
+	/**
+	 * Getting the counters of the queue
+	 * @return The counters of the queue
+	 */
+	const HXMessageQueueStats &Stats() const;
+
+private:
+	static bool IsMove(const HXMessage &Message);
+
+	static bool IsTransition(const HXMessage &Message);
+
+	/**
+	 * Removing the oldest move not sealed yet, the later messages are moved
+	 * forward to keep their order
+	 * @return If a move is removed, returning true, nor returning false
+	 */
+	bool EvictMove();
+
+	/**
+	 * Doubling the capacity of the ring, the messages keep their order
+	 */
+	void Grow();
+
+private:
+	HXVector<HXMessage, HXMemoryTag::Input> _ring;
+	size_t                                  _mask;
+	size_t                                  _head   = 0;
+	size_t                                  _size   = 0;
+	size_t                                  _sealed = 0;
+	HXMessageQueueStats                     _stats;
+};
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_profiler.h
+ * \brief The frame profiler of HiEasyX
+ */
+
+#pragma once
+
+#include <include/hex_string.h>
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**
+ * A timed span recorded by the profiler, the times are in nanoseconds since
+ * the profiler was created
+ */
+struct HXProfileEvent {
+	const char *Name   = nullptr;
+	uint64_t    Frame  = 0;
+	uint64_t    Begin  = 0;
+	uint64_t    End    = 0;
+	uint32_t    Thread = 0;
+
+	// The window or the text the span worked on, truncated and narrowed
+	char Label[32] = {};
+};
+
+/**
+ * The counters of a frame, the times are in nanoseconds
+ */
+struct HXFrameStats {
+	uint64_t Frame = 0;
+	uint64_t Start = 0;
+
+	// From HX::Begin to HX::End, and the time spent in HX::Render
+	uint64_t LayoutTime = 0;
+	uint64_t RenderTime = 0;
+
+	uint32_t Messages        = 0;
+	uint32_t Windows         = 0;
+	uint32_t WindowsReplayed = 0;
+	uint32_t DrawCommands    = 0;
+	uint32_t TextMeasures    = 0;
+	uint32_t CompositeTiles  = 0;
+
+	// The layouts whose cells were solved in this frame, and the ones which
+	// reused the cells solved by an earlier frame
+	uint32_t LayoutsSolved = 0;
+	uint32_t LayoutsCached = 0;
+
+	// The allocations made through the hooks from HX::Begin to HX::Render
+	uint32_t Allocations    = 0;
+	uint64_t AllocatedBytes = 0;
+};
+
+/**
+ * The profiler of a runtime context, the spans are written into a ring
+ * buffer so the latest ones are always kept without allocating, and the
+ * counters of the recent frames are kept in another ring. Recording is
+ * lock-free and can happen on the worker threads, the spans are only
+ * recorded when the profiler is enabled while the counters always are
+ */
+class HXProfiler {
+public:
+	/**
+	 * Constructing the profiler
+	 * @param Capacity The count of the spans kept, rounded up to a power of two
+	 * @param FrameCapacity The count of the frames whose counters are kept
+	 */
+	explicit HXProfiler(size_t Capacity = 16384, size_t FrameCapacity = 256);
+
+	HXProfiler(const HXProfiler &) = delete;
+
+	HXProfiler &operator=(const HXProfiler &) = delete;
+
+public:
+	void SetEnabled(bool Enable);
+
+	bool Enabled() const;
+
+	/**
+	 * Getting the time of the profiler
+	 * @return The nanoseconds since the profiler was created
+	 */
+	uint64_t Now() const;
+
+	/**
+	 * Recording a span, the label is copied
+	 * @param Name The name of the span, which must be a string living
+	 * forever like a literal
+	 * @param Label The window or the text the span worked on
+	 * @param Frame The frame of the span
+	 * @param Begin When the span began
+	 * @param End When the span ended
+	 */
+	void Record(const char *Name, HXStringView Label, uint64_t Frame, uint64_t Begin, uint64_t End);
+
+	/**
+	 * Opening a span which is not bound to a scope, like the layout of a
+	 * window lasting until the next window, the span opened before is
+	 * closed first. It must be called from the UI thread
+	 * @param Name The name of the span
+	 * @param Label The label of the span, which must live until it is closed
+	 * @param Frame The frame of the span
+	 */
+	void Open(const char *Name, HXStringView Label, uint64_t Frame);
+
+	/**
+	 * Closing the span opened by HXProfiler::Open, nothing is done if no
+	 * span is open
+	 */
+	void Close();
+
+	/**
+	 * Starting the counters of a new frame, the counters of the last frame
+	 * are moved to the history
+	 * @param Frame The index of the new frame
+	 */
+	void BeginFrame(uint64_t Frame);
+
+	/**
+	 * Getting the counters of the current frame
+	 * @return The counters of the current frame
+	 */
+	HXFrameStats &Stats();
+
+	/**
+	 * Writing the kept spans and frame counters as a Chrome trace, which
+	 * can be opened by chrome://tracing or Perfetto. It should be called
+	 * between the frames, when no worker is recording
+	 * @param Stream The stream to be written
+	 */
+	void ExportChromeTrace(std::ostream &Stream) const;
+
+private:
+	static uint32_t ThreadIndex();
+
+private:
+	std::vector<HXProfileEvent> _events;
+	size_t                      _mask;
+	std::atomic<uint64_t>       _next    = 0;
+	std::atomic<bool>           _enabled = false;
+	uint64_t                    _epoch;
+
+	std::vector<HXFrameStats> _frames;
+	uint64_t                  _frameCount = 0;
+	HXFrameStats              _current;
+
+	const char  *_openName = nullptr;
+	HXStringView _openLabel;
+	uint64_t     _openFrame = 0;
+	uint64_t     _openBegin = 0;
+};
+
+/**
+ * Recording the span of a scope when the profiler is enabled
+ */
+class HXProfileScope {
+public:
+	HXProfileScope(HXProfiler &Profiler, const char *Name, uint64_t Frame, HXStringView Label = {})
+		: _profiler(Profiler.Enabled() ? &Profiler : nullptr), _name(Name), _label(Label), _frame(Frame),
+		  _begin(_profiler != nullptr ? Profiler.Now() : 0) {
+	}
+
+	~HXProfileScope() {
+		if (_profiler != nullptr) {
+			_profiler->Record(_name, _label, _frame, _begin, _profiler->Now());
+		}
+	}
+
+	HXProfileScope(const HXProfileScope &) = delete;
+
+	HXProfileScope &operator=(const HXProfileScope &) = delete;
+
+private:
+	HXProfiler  *_profiler;
+	const char  *_name;
+	HXStringView _label;
+	uint64_t     _frame;
+	uint64_t     _begin;
+};
+
+#define HX_PROFILE_CONCAT_IMPL(A, B) A##B
+#define HX_PROFILE_CONCAT(A, B)      HX_PROFILE_CONCAT_IMPL(A, B)
+
+/**
+ * Profiling the rest of the scope, defining HEX_DISABLE_PROFILER compiles
+ * all the scopes out
+ */
+#ifdef HEX_DISABLE_PROFILER
+#	define HX_PROFILE_SCOPE(...)
+#else
+#	define HX_PROFILE_SCOPE(...) HXProfileScope HX_PROFILE_CONCAT(_profileScope, __LINE__)(__VA_ARGS__)
+#endif
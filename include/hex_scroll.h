@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_scroll.h
+ * \brief The scroll regions for HiEasyX
+ */
+
+#pragma once
+
+#include <include/hex_string.h>
+#include <include/impl/hex_impl.h>
+
+namespace HX {
+/**
+ * The profile for a scroll region
+ */
+struct ScrollProfile {
+	// The size of the viewport, set the width to a value less than 0
+	// (including 0) to fill the width of the window
+	HXPoint Size = {0, 200};
+
+	// How far the content is scrolled down, which is clamped to the content
+	HXGInt Offset = 0;
+
+	// The height of the content measured by the last HX::EndScroll
+	HXGInt ContentHeight = 0;
+
+	// When the thumb of the scroll bar is dragged, InDrag will be true
+	bool   InDrag     = false;
+	HXGInt DragOrigin = 0;
+	HXGInt DragOffset = 0;
+};
+
+/**
+ * Opening a scroll region, the widgets created until HX::EndScroll are laid
+ * out in the region and scrolled by the wheel and the scroll bar. The
+ * widgets entirely outside the viewport are neither drawn nor hit-tested,
+ * so a long content costs about the same as the part of it being seen. The
+ * identities of the widgets in the region are nested in its title
+ * @param Title The title of the region
+ * @param Profile The profile of the region
+ */
+void BeginScroll(HXStringView Title, ScrollProfile &Profile);
+
+/**
+ * Opening a scroll region whose state is kept by the context, the region is
+ * identified by its title nested in the identity stack
+ * @param Title The title of the region
+ * @param Size The size of the viewport
+ */
+void BeginScroll(HXStringView Title, HXPoint Size);
+
+/**
+ * Closing the scroll region opened by the last HX::BeginScroll, the content
+ * is measured and the scroll bar is drawn
+ */
+void EndScroll();
+}
+
+/**
+ * A scroll region opened in the current window
+ */
+struct HXScrollRegion {
+	// The profile of the region, a profile kept by the context is found
+	// again by its identity since the regions nested in the region may move
+	// the states of the context
+	HX::ScrollProfile *Profile = nullptr;
+	HXID               StateId = HXNoID;
+
+	// The viewport of the region relative to the window and the clip
+	// rectangle outside of the region, both with exclusive right and
+	// bottom edges
+	HXRect Viewport   = {0, 0, 0, 0};
+	HXRect ParentClip = {0, 0, 0, 0};
+};
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_spsc_queue.h
+ * \brief The lock-free queue between two threads
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+
+/**
+ * The bounded lock-free queue with a single producer and a single consumer,
+ * the producer and the consumer can run on different threads without any
+ * lock. Each side caches the last seen position of the other side, so the
+ * shared positions are only read again when the cached one says the queue
+ * is full or empty
+ * @tparam Element The type of the elements, which should be trivially copyable
+ * @tparam Capacity The count of the elements, which must be a power of two
+ */
+template<class Element, size_t Capacity>
+class HXSpscQueue {
+	static_assert(std::has_single_bit(Capacity), "The capacity must be a power of two");
+
+public:
+	/**
+	 * Pushing an element, which must be called only from the producer
+	 * @param Value The element to be pushed
+	 * @return If the queue is full, returning false, nor returning true
+	 */
+	bool TryPush(const Element &Value) {
+		const auto tail = _tail.load(std::memory_order_relaxed);
+		if (tail - _headCache == Capacity) {
+			_headCache = _head.load(std::memory_order_acquire);
+			if (tail - _headCache == Capacity) {
+				return false;
+			}
+		}
+
+		_slots[tail & (Capacity - 1)] = Value;
+		_tail.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	/**
+	 * Popping an element, which must be called only from the consumer
+	 * @param Value The element popped
+	 * @return If the queue is empty, returning false, nor returning true
+	 */
+	bool TryPop(Element &Value) {
+		const auto head = _head.load(std::memory_order_relaxed);
+		if (head == _tailCache) {
+			_tailCache = _tail.load(std::memory_order_acquire);
+			if (head == _tailCache) {
+				return false;
+			}
+		}
+
+		Value = _slots[head & (Capacity - 1)];
+		_head.store(head + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	/**
+	 * Checking whether the queue is empty, which can be called from both
+	 * sides, the answer may be outdated as soon as it is returned
+	 * @return If the queue is empty, returning true, nor returning false
+	 */
+	bool Empty() const {
+		return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+	}
+
+private:
+	// The positions of the two sides are kept on their own cache lines, so
+	// the producer and the consumer do not invalidate the lines of each other
+	static constexpr size_t CacheLine = 64;
+
+	alignas(CacheLine) std::atomic<size_t> _head = 0;
+	size_t _tailCache                           = 0;
+
+	alignas(CacheLine) std::atomic<size_t> _tail = 0;
+	size_t _headCache                           = 0;
+
+	alignas(CacheLine) std::array<Element, Capacity> _slots;
+};
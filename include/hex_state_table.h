@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_state_table.h
+ * \brief The table of the widget states keyed by their identities
+ */
+
+#pragma once
+
+#include <include/hex_id.h>
+#include <include/hex_memory.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * The open addressing table holding the state of every widget keyed by its
+ * identity. The slots are probed linearly in one flat array, so a lookup
+ * usually touches a single cache line. Every lookup stamps the slot with
+ * the frame, and the states not looked up for a while are released by
+ * HXStateTable::Collect
+ * @tparam Value The type of the states, which must be default constructible
+ */
+template<class Value>
+class HXStateTable {
+public:
+	/**
+	 * Constructing the table
+	 * @param Capacity The count of the slots, rounded up to a power of two
+	 */
+	explicit HXStateTable(size_t Capacity = 64) {
+		_slots.resize(std::bit_ceil(std::max<size_t>(Capacity, 8)));
+		_mask = _slots.size() - 1;
+	}
+
+public:
+	/**
+	 * Finding the state of a widget, a default state is created for the
+	 * widget seen for the first time
+	 * @param Id The identity of the widget
+	 * @param Frame The index of the current frame
+	 * @return The state of the widget, which is valid until the next
+	 * HXStateTable::Touch or HXStateTable::Collect
+	 */
+	Value &Touch(HXID Id, uint64_t Frame) {
+		size_t index = Probe(Id);
+		if (_slots[index].Id == HXNoID) {
+			// The load factor is kept under a half, so the probe sequences
+			// stay short
+			if ((_size + 1) * 2 > _slots.size()) {
+				Rehash(_slots.size() * 2);
+				index = Probe(Id);
+			}
+
+			_slots[index] = Slot{.Id = Id, .LastFrame = Frame, .State = Value{}};
+			++_size;
+		}
+		_slots[index].LastFrame = Frame;
+
+		return _slots[index].State;
+	}
+
+	/**
+	 * Finding the state of a widget without creating it
+	 * @param Id The identity of the widget
+	 * @return The state of the widget, nullptr if the widget has no state
+	 */
+	Value *Find(HXID Id) {
+		auto &slot = _slots[Probe(Id)];
+
+		return slot.Id == Id ? &slot.State : nullptr;
+	}
+
+	/**
+	 * Releasing the states of the widgets not seen since a frame
+	 * @param OldestFrame The oldest frame a kept widget must be seen in
+	 * @return The count of the released states
+	 */
+	size_t Collect(uint64_t OldestFrame) {
+		size_t stale = 0;
+		for (size_t index = 0; index < _slots.size();) {
+			auto &slot = _slots[index];
+			if (slot.Id == HXNoID || slot.LastFrame >= OldestFrame) {
+				++index;
+
+				continue;
+			}
+
+			// The slot is checked again, since Erase moves a later state of
+			// the probe sequence into it
+			Erase(index);
+			++stale;
+		}
+
+		return stale;
+	}
+
+	/**
+	 * Getting the count of the states held
+	 * @return The count of the states
+	 */
+	size_t Size() const {
+		return _size;
+	}
+
+private:
+	struct Slot {
+		HXID     Id        = HXNoID;
+		uint64_t LastFrame = 0;
+		Value    State     = {};
+	};
+
+	/**
+	 * Finding the slot of an identity, or the empty slot ending its probe
+	 * sequence when the identity is not in the table
+	 */
+	size_t Probe(HXID Id) const {
+		size_t index = static_cast<size_t>(Id) & _mask;
+		while (_slots[index].Id != HXNoID && _slots[index].Id != Id) {
+			index = (index + 1) & _mask;
+		}
+
+		return index;
+	}
+
+	/**
+	 * Emptying a slot by the backward shift deletion, the states after the
+	 * slot in the same probe sequence are moved back into the gap, so the
+	 * probe sequences stay unbroken without any tombstone
+	 */
+	void Erase(size_t Index) {
+		size_t gap = Index;
+		for (size_t index = (gap + 1) & _mask; _slots[index].Id != HXNoID; index = (index + 1) & _mask) {
+			// A state whose home slot lies between the gap and itself would
+			// be cut off from its home by moving it
+			const size_t home = static_cast<size_t>(_slots[index].Id) & _mask;
+			if (((index - home) & _mask) < ((index - gap) & _mask)) {
+				continue;
+			}
+
+			_slots[gap] = std::move(_slots[index]);
+			gap         = index;
+		}
+
+		_slots[gap] = Slot{};
+		--_size;
+	}
+
+	void Rehash(size_t Capacity) {
+		HXVector<Slot, HXMemoryTag::Layout> slots(Capacity);
+		std::swap(slots, _slots);
+
+		_mask = Capacity - 1;
+		_size = 0;
+		for (auto &slot : slots) {
+			if (slot.Id == HXNoID) {
+				continue;
+			}
+
+			_slots[Probe(slot.Id)] = std::move(slot);
+			++_size;
+		}
+	}
+
+	HXVector<Slot, HXMemoryTag::Layout> _slots;
+	size_t                              _mask = 0;
+	size_t                              _size = 0;
+};
@@ -28,16 +28,22 @@
 #pragma once
 
 #include <string>
-#include <windows.h>
+#include <string_view>
+
+#ifdef _WIN32
+#	include <windows.h>
+#endif
 
 #ifdef UNICODE
 
-using HXString = std::wstring;
+using HXString     = std::wstring;
+using HXStringView = std::wstring_view;
 #define HXStr(Text) L##Text
 
 #else
 
-using HXString = std::string;
+using HXString     = std::string;
+using HXStringView = std::string_view;
 #define HXStr(Text) (##Text)
 
 #endif
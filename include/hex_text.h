@@ -36,6 +36,10 @@ struct TextProfile {
 	HXGInt  Height = 18;
 	HXColor Color;
 
+	// The handle the font was interned into, which is only interned again
+	// by HX::Text once the font has been changed
+	HXFontHandle InternedFont;
+
 	TextProfile();
 };
 
@@ -43,12 +47,12 @@ struct TextProfile {
  * Creating a text label
  * @param Title The title of the text
  */
-void Text(const HXString &Title);
+void Text(HXStringView Title);
 
 /**
  * Creating a text label with a text profile
  * @param Title The title of the text
  * @param Profile The pointer to the text profile
  */
-void Text(const HXString &Title, TextProfile &Profile);
+void Text(HXStringView Title, TextProfile &Profile);
 }
\ No newline at end of file
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_thread_pool.h
+ * \brief The work-stealing thread pool
+ */
+
+#pragma once
+
+#include <include/hex_memory.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A group of tasks which can be waited together
+ */
+struct HXTaskGroup {
+	std::atomic<size_t> Pending = 0;
+};
+
+/**
+ * The work-stealing thread pool, every worker takes the tasks from the back
+ * of its own queue and steals from the front of the others when its queue
+ * runs dry. A thread waiting for a group runs the queued tasks instead of
+ * blocking, and sleeps once the tasks left are running elsewhere, so
+ * waiting never wastes a core
+ */
+class HXThreadPool {
+public:
+	/**
+	 * Constructing the pool
+	 * @param Workers The count of the worker threads
+	 */
+	explicit HXThreadPool(size_t Workers);
+
+	~HXThreadPool();
+
+	HXThreadPool(const HXThreadPool &) = delete;
+
+	HXThreadPool &operator=(const HXThreadPool &) = delete;
+
+public:
+	/**
+	 * Submitting a task to the pool, a worker submits to its own queue and
+	 * the other threads spread the tasks over the queues
+	 * @param Group The group the task belongs to
+	 * @param Function The function of the task
+	 * @param Argument The argument passed to the function
+	 */
+	void Submit(HXTaskGroup &Group, void (*Function)(void *), void *Argument);
+
+	/**
+	 * Waiting until all tasks of a group are finished, the calling thread
+	 * runs the queued tasks meanwhile
+	 * @param Group The group to be waited
+	 */
+	void Wait(HXTaskGroup &Group);
+
+	/**
+	 * Getting the count of the worker threads
+	 * @return The count of the workers
+	 */
+	size_t Workers() const;
+
+private:
+	struct Task {
+		void (*Function)(void *);
+		void        *Argument;
+		HXTaskGroup *Group;
+	};
+
+	// The tasks before Head were stolen, the storage is kept once the queue
+	// drains so the steady submissions allocate nothing
+	struct Queue {
+		std::mutex                          Lock;
+		HXVector<Task, HXMemoryTag::General> Tasks;
+		size_t                              Head = 0;
+
+		HX_TAGGED_NEW(HXMemoryTag::General)
+	};
+
+private:
+	void WorkerLoop(size_t Index);
+
+	bool TryTake(size_t Home, Task &Result);
+
+	void Run(const Task &Work);
+
+private:
+	std::vector<std::unique_ptr<Queue>> _queues;
+	std::vector<std::thread>            _threads;
+
+	// The count of the queued tasks, the idle workers and the waiters sleep
+	// until it rises or, for the waiters, until their group is done
+	std::atomic<size_t>     _queued = 0;
+	std::atomic<size_t>     _next   = 0;
+	std::mutex              _sleepLock;
+	std::condition_variable _wake;
+	bool                    _stop = false;
+};
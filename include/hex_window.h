@@ -27,6 +27,7 @@
  
 #pragma once
 
+#include <include/hex_id.h>
 #include <include/hex_string.h>
 #include <include/impl/hex_impl.h>
 
@@ -55,13 +56,27 @@ struct WindowProfile {
 	HXGInt  DeltaY          = 0;
 	HXGInt  OriginX         = 0;
 	HXGInt  OriginY         = 0;
+
+	// The opacity the window is composited onto the target with, 255 is
+	// opaque and 0 hides the window while keeping it interactive
+	HXColInt Opacity = 255;
 };
 
 /**
  * Creating a window, and select it into the working window,
- * the window will locate at the origin point by default.
+ * the window will locate at the origin point by default. The identity
+ * stack is reset to the identity of the window, the windows sharing a
+ * title are told apart by the order they are created in, a title written
+ * as a string literal is hashed at compile time
  * @param Title The title of the window
  * @param Profile The profile for a window
  */
-void Window(const HXString &Title, WindowProfile &Profile);
+void Window(HXTitle Title, WindowProfile &Profile);
+
+/**
+ * Creating a window whose profile is kept by the context, the window is
+ * identified by its title
+ * @param Title The title of the window
+ */
+void Window(HXTitle Title);
 }
\ No newline at end of file
@@ -33,6 +33,7 @@
 
 #define HEX_IMPLEMENTATION
 
+#include <include/impl/hex_glyph_atlas.h>
 #include <include/impl/hex_impl.h>
 
 #include <graphics.h>
@@ -65,15 +66,21 @@ public:
 
 	void DrawPainter(HXBufferPainter *Painter, HXPoint Where) override;
 
-	void DrawText(const HXString &Text, HXFont Font, HXPoint Where, HXColor Color, HXGUInt Height) override;
+	void DrawPainterRegion(HXBufferPainter *Painter, HXPoint Where, HXRect Region, HXColInt Opacity) override;
 
-	void DrawFilledPolygon(std::vector<HXPoint> Points, HXColor Color) override;
+	void DrawText(HXStringView Text, HXFontHandle Font, HXPoint Where, HXColor Color, HXGUInt Height) override;
+
+	void DrawFilledPolygon(const HXPoint *Points, size_t Count, HXColor Color) override;
 
 	void DrawFilledRoundedRectangle(HXRect Rect, HXColor Color, HXColor FillColor, HXGInt Radius) override;
 
 	void Clear(HXColor Color) override;
 
-	HXRect MeasureText(const HXString &Text, HXFont Font, HXGUInt Height) override;
+	HXRect MeasureText(HXStringView Text, HXFontHandle Font, HXGUInt Height) override;
+
+	void SetClipRect(HXRect Rect) override;
+
+	void ResetClipRect() override;
 
 public:
 	HXBufferPainter *CreateSubPainter(HXGInt Width, HXGInt Height) override;
@@ -85,11 +92,58 @@ public:
 
 	void End() override;
 
+	void Resize(HXGInt Width, HXGInt Height) override;
+
 private:
-	static void SetupEasyXFont(HXFont Font, HXGUInt Height);
+	/**
+	 * Applying a font to the working image, nothing is done when the font
+	 * and the height are the ones applied to the image last time
+	 */
+	static void SetupEasyXFont(HXFontHandle Font, HXGUInt Height);
+
+	/**
+	 * Rasterizing a glyph with GDI and caching its coverage in the atlas
+	 * @param Character The units of the character, a multibyte or a
+	 * surrogate pair character takes more than one unit
+	 */
+	const HXGlyph &RasterizeGlyph(const HXGlyphKey &Key, HXFontHandle Font, HXStringView Character);
+
+	/**
+	 * Blending the coverage of a cached glyph with the color onto the image
+	 */
+	void BlitGlyph(const HXGlyph &Glyph, const uint8_t *Coverage, HXPoint Where, HXColor Color);
+
+	/**
+	 * Getting the rectangle the drawings are limited to, the glyphs and the
+	 * mixed painters are written straight into the image buffer, so they
+	 * are clipped by hand instead of by the clip region of GDI
+	 * @return The drawable rectangle, the right and the bottom edges are
+	 * exclusive
+	 */
+	HXRect Bounds() const;
 
 protected:
 	IMAGE *_buffer;
+
+	// The logical size of the painter, which can be smaller than the image
+	// when the image is reserved with some headroom
+	HXGInt _width  = 0;
+	HXGInt _height = 0;
+
+private:
+	// The points of the polygon being drawn in the layout of GDI, kept to
+	// be reused by the next polygon
+	HXVector<POINT, HXMemoryTag::Painter> _polygon;
+
+	// The text being measured or drawn as a terminated string
+	HXTaggedString<HXMemoryTag::Text> _terminated;
+
+	// The glyphs of the text being drawn, which are only blitted once the
+	// whole text is found to be drawable from the atlas
+	HXVector<HXGlyph, HXMemoryTag::Text> _run;
+
+	HXRect _clip    = {0, 0, 0, 0};
+	bool   _clipped = false;
 };
 
 class HXExHostedBufferPainterImpl : public HXBufferPainterImpl {
@@ -97,6 +151,9 @@ public:
 	HXExHostedBufferPainterImpl(HXGInt Width, HXGInt Height);
 
 	~HXExHostedBufferPainterImpl() override;
+
+public:
+	void Resize(HXGInt Width, HXGInt Height) override;
 };
 
 class HXContextImpl : public HXContext {
@@ -141,4 +198,6 @@ public:
 
 public:
 	void SetCursorStyle(HXCursorStyle Style) override;
+
+	HXPeekResult PeekInput() override;
 };
\ No newline at end of file
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * \file hex_impl_software.h
+ * \brief The HiEasyX impl of a headless CPU rasterizer
+ */
+
+#pragma once
+
+#ifdef HEX_IMPLEMENTATION
+#	error Should only include one HiEasyX UI implementation at once!
+#endif
+
+#define HEX_IMPLEMENTATION
+
+#include <include/impl/hex_glyph_atlas.h>
+#include <include/impl/hex_impl.h>
+
+#include <memory>
+#include <vector>
+
+/**
+ * The plain RGBA surface the software implementation rasterizes into,
+ * the pixels are stored row by row without any padding and with the alpha
+ * premultiplied
+ */
+struct HXSoftwareBuffer {
+	HXBuffer *Pixels = nullptr;
+	HXGInt    Width  = 0;
+	HXGInt    Height = 0;
+};
+
+/**
+ * The type of the input message for the software implementation
+ */
+enum class HXSoftwareMessageType {
+	MouseMove,
+	MouseLeftDown,
+	MouseLeftUp,
+	MouseWheel
+};
+
+/**
+ * The input message for the software implementation, the host translates
+ * its own input into this structure before pushing it
+ */
+struct HXSoftwareMessage {
+	HXSoftwareMessageType Type = HXSoftwareMessageType::MouseMove;
+	HXGInt                X    = 0;
+	HXGInt                Y    = 0;
+
+	// The distance a wheel message rolled, 120 for every notch
+	HXGInt Wheel = 0;
+};
+
+// The entries work on the runtime context current on the calling thread, and
+// every thread gets its own implementation state
+namespace HX {
+void HXBegin();
+void HXInitForSoftware(HXSoftwareBuffer *Device);
+void *GetHXBuffer(HXSoftwareBuffer *Buffer);
+}
+
+class HXBufferPainterImpl : public HXBufferPainter {
+public:
+	/**
+	 * Constructing the buffer painter
+	 * @param Buffer The buffer to be drawn
+	 */
+	explicit HXBufferPainterImpl(HXSoftwareBuffer *Buffer);
+
+	~HXBufferPainterImpl() override = default;
+
+public:
+	void DrawLine(HXPoint Point1, HXPoint Point2, HXColor Color) override;
+
+	void DrawRectangle(HXRect Rect, HXColor Color) override;
+
+	void DrawFilledRectangle(HXRect Rect, HXColor Color, HXColor FillColor) override;
+
+	void DrawPainter(HXBufferPainter *Painter, HXPoint Where) override;
+
+	void DrawPainterRegion(HXBufferPainter *Painter, HXPoint Where, HXRect Region, HXColInt Opacity) override;
+
+	void DrawText(HXStringView Text, HXFontHandle Font, HXPoint Where, HXColor Color, HXGUInt Height) override;
+
+	void DrawFilledPolygon(const HXPoint *Points, size_t Count, HXColor Color) override;
+
+	void DrawFilledRoundedRectangle(HXRect Rect, HXColor Color, HXColor FillColor, HXGInt Radius) override;
+
+	void Clear(HXColor Color) override;
+
+	HXRect MeasureText(HXStringView Text, HXFontHandle Font, HXGUInt Height) override;
+
+	void SetClipRect(HXRect Rect) override;
+
+	void ResetClipRect() override;
+
+public:
+	HXBufferPainter *CreateSubPainter(HXGInt Width, HXGInt Height) override;
+
+	HXBufferPainter *CreateFromBuffer(void *Buffer) override;
+
+public:
+	void Begin() override;
+
+	void End() override;
+
+	void Resize(HXGInt Width, HXGInt Height) override;
+
+public:
+	/**
+	 * Getting the surface this painter draws on
+	 * @return The surface descriptor of the painter
+	 */
+	const HXSoftwareBuffer &Surface() const;
+
+private:
+	/**
+	 * Getting the rectangle the drawings are limited to, which is the
+	 * surface clipped by the clip rectangle
+	 * @return The drawable rectangle, the right and the bottom edges are
+	 * exclusive
+	 */
+	HXRect Bounds() const;
+
+	/**
+	 * Filling the horizontal span [Left, Right] of the row Y, the span
+	 * will be clipped into the drawable rectangle
+	 */
+	void FillSpan(HXGInt Y, HXGInt Left, HXGInt Right, HXColor Color);
+
+	void PlotPixel(HXGInt X, HXGInt Y, HXColor Color);
+
+	/**
+	 * Blending the coverage of a cached glyph with the color onto the surface
+	 */
+	void BlitGlyph(const HXGlyph &Glyph, const uint8_t *Coverage, HXPoint Where, HXColor Color);
+
+protected:
+	HXSoftwareBuffer *_buffer;
+
+private:
+	HXVector<HXGInt, HXMemoryTag::Painter> _crossings;
+
+	HXRect _clip    = {0, 0, 0, 0};
+	bool   _clipped = false;
+};
+
+class HXExHostedBufferPainterImpl : public HXBufferPainterImpl {
+public:
+	HXExHostedBufferPainterImpl(HXGInt Width, HXGInt Height);
+
+public:
+	void Resize(HXGInt Width, HXGInt Height) override;
+
+private:
+	HXSoftwareBuffer                              _hosted;
+	HXTaggedArray<HXBuffer, HXMemoryTag::Painter> _pixels;
+	size_t                                        _capacity = 0;
+};
+
+class HXContextImpl : public HXContext {
+public:
+	HXContextImpl();
+
+	~HXContextImpl() override = default;
+
+public:
+	HXBufferPainter *BufferToPainter(void *Buffer) override;
+
+	HXBufferPainter *DefaultPainter() override;
+
+	HXBuffer *GetDeviceBuffer() override;
+
+	bool ParallelPainting() override;
+
+public:
+	/**
+	 * Setting the surface treated as the device of this context
+	 * @param Device The device surface
+	 */
+	void SetDevice(HXSoftwareBuffer *Device);
+
+private:
+	HXSoftwareBuffer                     _empty;
+	std::unique_ptr<HXBufferPainterImpl> _defaultPainter;
+	HXSoftwareBuffer *                   _device = nullptr;
+};
+
+namespace HX {
+/**
+ * Converting the software message to the HX message format
+ * @param Message The message to be converted
+ * @return The converted HX message type
+ */
+void *GetHXMessage(HXSoftwareMessage *Message);
+}
+
+class HXMessageSenderImpl : public HXMessageSender {
+public:
+	HXMessageSenderImpl() = default;
+
+	~HXMessageSenderImpl() override = default;
+
+public:
+	HXMessage Message(void *Message) override;
+};
+
+class HXOSOperationImpl : public HXOSOperation {
+public:
+	~HXOSOperationImpl() override = default;
+
+public:
+	void SetCursorStyle(HXCursorStyle Style) override;
+
+	HXPeekResult PeekInput() override;
+
+public:
+	/**
+	 * Getting the cursor style requested by the UI, there is no real
+	 * cursor in the headless mode so the host can query it here
+	 * @return The last requested cursor style
+	 */
+	HXCursorStyle CursorStyle() const;
+
+private:
+	HXCursorStyle _style = HXCursorStyle::Normal;
+};
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_blend.h
+ * \brief The pixel blending kernels shared by the implementations
+ */
+
+#pragma once
+
+#include <include/impl/hex_impl.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Premultiplying a color by its alpha, the painters holding alpha store
+ * their pixels premultiplied
+ * @param Color The straight color
+ * @return The premultiplied color
+ */
+constexpr HXColor HXPremultiply(HXColor Color) {
+	return {static_cast<HXColInt>((Color.R * Color.A + 127) / 255),
+	        static_cast<HXColInt>((Color.G * Color.A + 127) / 255),
+	        static_cast<HXColInt>((Color.B * Color.A + 127) / 255), Color.A};
+}
+
+/**
+ * Compositing a row of premultiplied pixels over another row, the source is
+ * scaled by the opacity first. The widest kernel the processor supports is
+ * selected on the first call
+ * @param Target The row to be blended onto
+ * @param Source The premultiplied row to be drawn
+ * @param Count The count of the pixels in the rows
+ * @param Opacity The opacity applied to the whole source, 255 is opaque
+ */
+void HXBlendRow(HXBuffer *Target, const HXBuffer *Source, size_t Count, HXColInt Opacity);
+
+/**
+ * Mixing a row of pixels without alpha into another row with a constant
+ * opacity, every byte of the pixels is mixed alike, so the layout of the
+ * channels does not matter
+ * @param Target The row to be mixed onto
+ * @param Source The row to be drawn
+ * @param Count The count of the pixels in the rows
+ * @param Opacity The opacity of the source, 255 is opaque
+ */
+void HXMixRow(uint32_t *Target, const uint32_t *Source, size_t Count, HXColInt Opacity);
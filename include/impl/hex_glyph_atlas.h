@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * \file hex_glyph_atlas.h
+ * \brief The glyph cache shared by the implementations
+ */
+
+#pragma once
+
+#include <include/font/hex_font.h>
+#include <include/hex_geo.h>
+#include <include/hex_hash.h>
+#include <include/hex_memory.h>
+
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The key of a cached glyph
+ */
+struct HXGlyphKey {
+	HXHash  Font;
+	HXGUInt Height;
+	HXGUInt Code;
+
+	bool operator==(const HXGlyphKey &) const = default;
+};
+
+/**
+ * A glyph rasterized into the atlas, the coverage of the glyph is stored as
+ * one byte per pixel in a page of the atlas
+ */
+struct HXGlyph {
+	uint32_t Page;
+	HXGInt   X;
+	HXGInt   Y;
+	HXGInt   Width;
+	HXGInt   Height;
+
+	// How far the pen moves after drawing the glyph
+	HXGInt Advance;
+};
+
+/**
+ * The cache of rasterized glyphs, every glyph is rasterized by the
+ * implementation only once and then drawn as a blit of its coverage.
+ * The glyphs are packed into fixed size pages row by row, and the whole
+ * atlas is flushed when it grows beyond its page limit
+ */
+class HXGlyphAtlas {
+public:
+	/**
+	 * Finding a cached glyph
+	 * @param Key The key of the glyph
+	 * @return The glyph found, or nullptr if the glyph was never inserted
+	 */
+	const HXGlyph *Find(const HXGlyphKey &Key) const;
+
+	/**
+	 * Inserting a rasterized glyph into the atlas, the returned glyph stays
+	 * valid until the next insertion
+	 * @param Key The key of the glyph
+	 * @param Width The width of the coverage
+	 * @param Height The height of the coverage
+	 * @param Advance How far the pen moves after drawing the glyph
+	 * @param Coverage The coverage of the glyph, Width * Height bytes
+	 * @return The inserted glyph
+	 */
+	const HXGlyph &Insert(const HXGlyphKey &Key, HXGInt Width, HXGInt Height, HXGInt Advance,
+	                      const uint8_t *Coverage);
+
+	/**
+	 * Getting the coverage of the top left pixel of a glyph, the rows of
+	 * the coverage are Stride() bytes apart
+	 * @param Glyph The glyph in the atlas
+	 * @return The coverage of the glyph
+	 */
+	const uint8_t *Coverage(const HXGlyph &Glyph) const;
+
+	/**
+	 * Getting the distance between two rows in a page
+	 * @return The stride of the pages
+	 */
+	static constexpr HXGInt Stride() {
+		return PageSize;
+	}
+
+	/**
+	 * Getting the count of the cached glyphs
+	 * @return The count of the glyphs
+	 */
+	size_t Size() const;
+
+	/**
+	 * Dropping all cached glyphs
+	 */
+	void Flush();
+
+private:
+	static constexpr HXGInt PageSize = 1024;
+	static constexpr size_t MaxPages = 16;
+
+	struct KeyHasher {
+		size_t operator()(const HXGlyphKey &Key) const {
+			return static_cast<size_t>(HXHashCombine(HXHashCombine(Key.Font, Key.Height), Key.Code));
+		}
+	};
+
+	HXHashMap<HXGlyphKey, HXGlyph, HXMemoryTag::Text, KeyHasher>      _glyphs;
+	HXVector<HXVector<uint8_t, HXMemoryTag::Text>, HXMemoryTag::Text> _pages;
+
+	// The shelf the next glyph is packed into
+	HXGInt _shelfX      = 0;
+	HXGInt _shelfY      = 0;
+	HXGInt _shelfHeight = 0;
+};
@@ -29,6 +29,7 @@
 
 #include <include/hex_geo.h>
 #include <include/font/hex_font.h>
+#include <include/hex_memory.h>
 
 #include <vector>
 
@@ -54,6 +55,19 @@ struct HXBuffer {
 using HXColor     = HXBuffer;
 using HXBufferPtr = HXBuffer *;
 
+/**
+ * Calculating the capacity a growing painter should reserve, leaving some
+ * headroom so that an interactive resize does not reallocate every frame
+ * @param Required The size required by the painter
+ * @return The capacity to be allocated
+ */
+inline HXGInt HXPainterCapacity(HXGInt Required) {
+	constexpr HXGInt granularity = 64;
+
+	const HXGInt grown = Required + Required / 2;
+	return (grown + granularity - 1) / granularity * granularity;
+}
+
 /**
  * The abstracted painter for a HXBufferPtr
  */
@@ -61,6 +75,9 @@ HX_IMPL_API class HXBufferPainter {
 public:
 	virtual ~HXBufferPainter() = default;
 
+	// The painters of every implementation are counted as painter memory
+	HX_TAGGED_NEW(HXMemoryTag::Painter)
+
 public:
 	/**
 	 * Drawing a line on the buffer
@@ -90,9 +107,10 @@ public:
 	/**
 	 * Drawing a filled polygon
 	 * @param Points Points of the polygon
+	 * @param Count The count of the points
 	 * @param Color The color to fill the polygon
 	 */
-	virtual void DrawFilledPolygon(std::vector<HXPoint> Points, HXColor Color) = 0;
+	virtual void DrawFilledPolygon(const HXPoint *Points, size_t Count, HXColor Color) = 0;
 
 	/**
 	 * Drawing a rectangle on the buffer
@@ -102,12 +120,23 @@ public:
 	virtual void DrawRectangle(HXRect Rect, HXColor Color) = 0;
 
 	/**
-	 * Drawing a painter to this painter
+	 * Drawing a painter to this painter, the pixels of the painter are
+	 * composited over this painter by their alpha
 	 * @param Painter The painter to be drawn on this painter
 	 * @param Where Where to draw the painter
 	 */
 	virtual void DrawPainter(HXBufferPainter *Painter, HXPoint Where) = 0;
 
+	/**
+	 * Drawing the part of a painter which falls into a region of this painter
+	 * @param Painter The painter to be drawn on this painter
+	 * @param Where Where to draw the painter
+	 * @param Region The region of this painter to be updated, the right and
+	 * the bottom edges are exclusive
+	 * @param Opacity The opacity applied to the whole painter, 255 is opaque
+	 */
+	virtual void DrawPainterRegion(HXBufferPainter *Painter, HXPoint Where, HXRect Region, HXColInt Opacity) = 0;
+
 	/**
 	 * Drawing the text on the buffer
 	 * @param Text The text to be drawn
@@ -116,7 +145,7 @@ public:
 	 * @param Color The color of the text
 	 * @param Height The height of the text
 	 */
-	virtual void DrawText(const HXString &Text, HXFont Font, HXPoint Where, HXColor Color, HXGUInt Height) = 0;
+	virtual void DrawText(HXStringView Text, HXFontHandle Font, HXPoint Where, HXColor Color, HXGUInt Height) = 0;
 
 	/**
 	 * Clearing the painter with specified color
@@ -131,7 +160,21 @@ public:
 	 * @param Height The height of the font
 	 * @return The rectangle of the font measured
 	 */
-	virtual HXRect MeasureText(const HXString &Text, HXFont Font, HXGUInt Height) = 0;
+	virtual HXRect MeasureText(HXStringView Text, HXFontHandle Font, HXGUInt Height) = 0;
+
+	/**
+	 * Limiting the following drawings to a rectangle of the painter, the
+	 * pixels outside the rectangle are left untouched
+	 * @param Rect The rectangle to draw in, the right and the bottom edges
+	 * are exclusive
+	 */
+	virtual void SetClipRect(HXRect Rect) = 0;
+
+	/**
+	 * Removing the clip rectangle, the following drawings cover the whole
+	 * painter again
+	 */
+	virtual void ResetClipRect() = 0;
 
 public:
 	/**
@@ -144,6 +187,15 @@ public:
 	 */
 	virtual void End() = 0;
 
+	/**
+	 * Resizing the painter, the content of the painter is undefined after
+	 * resizing, the backing storage will only be reallocated when the new
+	 * size grows beyond the capacity of the painter
+	 * @param Width The new width of the painter
+	 * @param Height The new height of the painter
+	 */
+	virtual void Resize(HXGInt Width, HXGInt Height) = 0;
+
 public:
 	/**
 	 * Creating a sub painter
@@ -187,6 +239,15 @@ public:
 	 * @return The buffer to the main device
 	 */
 	virtual HXBuffer *GetDeviceBuffer() = 0;
+
+	/**
+	 * Checking whether different painters of the context can be drawn on
+	 * different threads at the same time
+	 * @return If the painters are independent, returning true, nor returning false
+	 */
+	virtual bool ParallelPainting() {
+		return false;
+	}
 };
 
 struct HXMessage {
@@ -196,6 +257,10 @@ struct HXMessage {
 	bool   MouseAction      = false;
 	HXGInt MouseX           = 0;
 	HXGInt MouseY           = 0;
+
+	// The distance the wheel rolled, 120 for a notch away from the user and
+	// -120 for a notch towards the user, a wheel message is a mouse action
+	HXGInt MouseWheel = 0;
 };
 
 HX_IMPL_API class HXMessageSender {
@@ -219,10 +284,28 @@ enum class HXCursorStyle {
 	ResizeE   // ←→
 };
 
+/**
+ * What a peek at the input of the OS found
+ */
+enum class HXPeekResult {
+	Unsupported, // The input is pushed by the host, the OS is not peeked
+	Input,       // The OS has input for the application
+	Empty        // The OS has no input for the application
+};
+
 HX_IMPL_API class HXOSOperation {
 public:
 	virtual ~HXOSOperation() = default;
 
 public:
 	virtual void SetCursorStyle(HXCursorStyle Style) = 0;
+
+	/**
+	 * Checking whether the OS has input for the application without
+	 * blocking, the input is left in the OS for the host to take. The
+	 * waiting is done by HX::WaitForEvents, which also wakes for the
+	 * messages pushed by the other threads
+	 * @return What the peek found
+	 */
+	virtual HXPeekResult PeekInput() = 0;
 };
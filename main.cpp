@@ -17,12 +17,7 @@ int main() {
 		exit(-1);
 	}
 
-	HX::WindowProfile windowProfile;
-
 	while (true) {
-		setbkcolor(RGB(0, 129, 129));
-		cleardevice();
-
 		HX::HXBegin();
 
 		// Begin to process the message
@@ -31,14 +26,15 @@ int main() {
 			HX::PushMessage(HX::GetHXMessage(&message));
 		}
 
-		HX::Window("Hello World", windowProfile);
+		HX::Window("Hello World");
 
 		static HX::ButtonProfile btnProfile{};
 		if (HX::Button("Hello World!", btnProfile)) {
 			HX::Text("You clicked the button!");
 		}
 		if (btnProfile.OnHold) {
-			auto profile        = HX::TextProfile{};
+			// The profile is kept, so its font is only interned once
+			static auto profile = HX::TextProfile{};
 			profile.Height      = 20;
 			profile.Color       = HXColor{255, 0, 0};
 			profile.Font.Style  = HXFontStyle::Black;
@@ -53,14 +49,34 @@ int main() {
 
 		HX::End();
 
+		// Only the damaged regions need their background repainted
+		setbkcolor(RGB(0, 129, 129));
+		setfillcolor(RGB(0, 129, 129));
+		if (HX::IsFullyDamaged()) {
+			cleardevice();
+		} else {
+			for (auto &dirty : HX::GetDirtyRects()) {
+				solidrectangle(dirty.Left, dirty.Top, dirty.Right - 1, dirty.Bottom - 1);
+			}
+		}
+
+		const bool fullyDamaged = HX::IsFullyDamaged();
+		const auto dirtyBounds  = HX::GetDirtyBounds();
+
 		HX::SetBuffer(HX::GetHXBuffer(GetWorkingImage()));
 		HX::Render();
 
 		_flushall();
 
-		FlushBatchDraw();
+		if (fullyDamaged) {
+			FlushBatchDraw();
+		} else if (!dirtyBounds.IsEmpty()) {
+			FlushBatchDraw(dirtyBounds.Left, dirtyBounds.Top, dirtyBounds.Right - 1, dirtyBounds.Bottom - 1);
+		}
 
-		Sleep(1);
+		// Sleeping until the next input instead of spinning, an idle UI does
+		// not lay out or render anything
+		HX::WaitForEvents();
 	}
 
 	return 0;
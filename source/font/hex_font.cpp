@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_font.cpp
+ * \brief The font wrappers
+ */
+
+#include <include/font/hex_font.h>
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace HX {
+/**
+ * The table of all interned fonts, the records are kept in a deque so that
+ * interning a new font never moves the old ones
+ */
+struct _FontTable {
+	std::mutex                                               Lock;
+	std::deque<HXInternedFont>                               Fonts;
+	std::unordered_multimap<HXHash, const HXInternedFont *> Index;
+};
+
+_FontTable &_GetFontTable() {
+	static _FontTable table;
+	return table;
+}
+
+const HXInternedFont *_InternFont(const HXFont &Font) {
+	const auto key   = HXFontKey(Font);
+	auto      &table = _GetFontTable();
+
+	std::lock_guard lock(table.Lock);
+	for (auto [begin, end] = table.Index.equal_range(key); begin != end; ++begin) {
+		if (begin->second->Font == Font) {
+			return begin->second;
+		}
+	}
+
+	auto &font = table.Fonts.emplace_back(
+		HXInternedFont{.Font = Font, .Key = key, .Index = static_cast<uint32_t>(table.Fonts.size())});
+	table.Index.emplace(key, &font);
+
+	return &font;
+}
+}
+
+HXFontHandle::HXFontHandle() {
+	static const HXInternedFont *defaultFont = HX::_InternFont(HXFont{});
+
+	_font = defaultFont;
+}
+
+HXFontHandle::HXFontHandle(const HXFont &Font) : _font(HX::_InternFont(Font)) {
+}
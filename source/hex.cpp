@@ -27,105 +27,944 @@
 
 #include <include/hex.h>
 
+#include <algorithm>
+#include <fstream>
 #include <map>
 #include <vector>
 
 namespace HX {
-HXTheme          Theme;
-HXRuntimeContext Context;
-HXMessageSender *MsgSender;
+// How many frames a window can skip before it gets released from the pool
+constexpr uint64_t WindowRetainFrames = 60;
+
+// When there are more damaged regions than this, they collapse into their union
+constexpr size_t MaxDirtyRects = 16;
+
+// The size of the tiles the target is split into for compositing in parallel
+constexpr HXGInt CompositeTileSize = 256;
+
+/**
+ * The theme used by the contexts until they create their own one
+ */
+HXTheme _DefaultTheme() {
+	return HXTheme{
+		.WindowBackground = HXColor{21, 22, 23, 255},
+		.WindowTitleText = HXColor{255, 255, 255, 255},
+		.WindowTitleBackground = HXColor{41, 74, 122, 255},
+		.ButtonBorder = HXColor{39, 73, 114, 255},
+		.ButtonBackground = HXColor{39, 73, 114, 255},
+		.ButtonText = HXColor{255, 255, 255, 255},
+		.ButtonOnHoverBorder = HXColor{49, 83, 124, 255},
+		.ButtonOnHoverBackground = HXColor{49, 83, 124, 255},
+		.ButtonOnHoverText = HXColor{255, 255, 255, 255},
+		.ButtonPressedBorder = HXColor{59, 93, 134, 255},
+		.ButtonPressedBackground = HXColor{59, 93, 134, 255},
+		.ButtonPressedText = HXColor{255, 255, 255, 255},
+	};
+}
+
+// The context used by every thread which never selected another one, which
+// keeps the single UI programs working without creating any context
+HXRuntimeContext DefaultContext;
+
+thread_local HXRuntimeContext *CurrentContext = &DefaultContext;
 
 HXRuntimeContext &GetContext() {
-	return Context;
+	return *CurrentContext;
+}
+
+HXRuntimeContext *CreateContext() {
+	auto context   = new HXRuntimeContext;
+	context->Theme = _DefaultTheme();
+
+	return context;
+}
+
+void DestroyContext(HXRuntimeContext *Context) {
+	if (Context == nullptr || Context == &DefaultContext) {
+		return;
+	}
+	if (CurrentContext == Context) {
+		CurrentContext = &DefaultContext;
+	}
+
+	delete Context;
+}
+
+void SetCurrentContext(HXRuntimeContext *Context) {
+	CurrentContext = Context != nullptr ? Context : &DefaultContext;
 }
 
 HXTheme &GetTheme() {
-	return Theme;
+	return GetContext().Theme;
 }
 
 HXPoint _ClipToLocalWindowCoord(HXPoint Coord) {
-	return {Coord.X - Context.CurrentWindow->Where.X, Coord.Y - Context.CurrentWindow->Where.Y};
+	auto &context = GetContext();
+
+	return {Coord.X - context.CurrentWindow->Where.X, Coord.Y - context.CurrentWindow->Where.Y};
 }
 
 void SetBuffer(void *Buffer) {
-	Context.LocalBuffer = Buffer;
+	GetContext().LocalBuffer = Buffer;
 }
 
 void OSAPI(HXOSOperation *API) {
-	Context.OSAPI = API;
+	GetContext().OSAPI = API;
 }
 
 HXString GetLastError() {
-	return Context.LastError;
-}gui
+	return GetContext().LastError;
+}
 
 void MessageSender(HXMessageSender *Sender) {
-	MsgSender = Sender;
+	auto &context = GetContext();
+
+	context.MsgSender = Sender;
 	if (Sender == nullptr) {
-		Context.Win       = false;
-		Context.LastError = "Invalid message sender";
+		context.Win       = false;
+		context.LastError = "Invalid message sender";
+	}
+}
+
+void PushMessage(HXRuntimeContext &Context, void *Message) {
+	if (!Context.InputQueue.TryPush(Context.MsgSender->Message(Message))) {
+		Context.InputDropped.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// The sleeping thread raises the flag before looking at the queue, and
+	// this thread fills the queue before looking at the flag, so the fences
+	// make sure at least one of them sees the other. The lock is only taken
+	// when there is someone to wake
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (Context.Sleeping.load(std::memory_order_relaxed)) {
+		std::lock_guard lock(Context.WakeLock);
+		Context.WakeSignal.notify_all();
 	}
 }
 
 void PushMessage(void *Message) {
-	Context.MessageQuery.push_back(MsgSender->Message(Message));
+	PushMessage(GetContext(), Message);
 }
 
-void Begin(HXContext *RenderContext) {
-	for (auto &window : Context.Windows) {
-		delete window;
+/**
+ * Moving the messages pushed so far from the input queue to the message
+ * query of this frame
+ */
+void _DrainInput(HXRuntimeContext &Context) {
+	HXMessage message;
+	while (Context.InputQueue.TryPop(message)) {
+		Context.MessageQuery.Push(message);
 	}
+}
+
+void Begin(HXContext *RenderContext) {
+	auto &context = GetContext();
 
-	Context.Windows.clear();
+	context.Windows.clear();
 
-	if (Context.Initialized) {
-		Context.Win       = false;
-		Context.LastError = "End is needed for another UI layout progress";
+	if (context.Initialized) {
+		context.Win       = false;
+		context.LastError = "End is needed for another UI layout progress";
 	} else {
-		Context               = HXRuntimeContext{};
-		Context.RenderContext = RenderContext;
-		Context.Initialized   = true;
+		// The windows in the pool survive, only the per frame state is reset
+		context.FrameArena.Reset();
+		context.MessageQuery.Clear();
+		_DrainInput(context);
+		context.RoutedMessages   = 0;
+		context.LastMouseMessage = HXNoMessage;
+		context.CurrentWindow    = nullptr;
+		context.OSAPI            = nullptr;
+		context.LocalBuffer      = nullptr;
+		context.LastError.clear();
+		context.IDStack.clear();
+		context.Win = true;
+
+		// The inboxes index the messages of the last frame, a frame without
+		// messages never routes and would read them again
+		for (auto &[id, window] : context.WindowPool) {
+			window->Inbox.clear();
+			window->ControlInbox.clear();
+			window->ControlCursor = 0;
+		}
+
+		// The measurements depend on the implementation measuring them
+		if (context.RenderContext != RenderContext) {
+			context.MeasureCache.Clear();
+		}
+
+		context.RenderContext = RenderContext;
+		context.Initialized   = true;
+		++context.Frame;
+		context.Profiler.BeginFrame(context.Frame);
+
+		context.FrameMemoryStart = HXGetMemoryStats();
+		if (context.MemorySteady && context.AllocationGuard != HXAllocationGuard::Off) {
+			context.GuardedAtBegin = HXGuardedAllocations();
+			context.TaskGuarded.store(0, std::memory_order_relaxed);
+			HXArmAllocationGuard(context.AllocationGuard);
+		}
+
+		// The requested frame is this one once it is due
+		if (context.FrameDeadline <= std::chrono::steady_clock::now()) {
+			context.FrameDeadline = std::chrono::steady_clock::time_point::max();
+		}
+	}
+}
+
+void _AddDirtyRect(HXRuntimeContext &Context, HXRect Rect) {
+	if (Rect.IsEmpty() || Context.FullDamage) {
+		return;
+	}
+
+	// Merging the overlapped regions, the merged one may overlap others so
+	// the list is scanned again until it is stable
+	for (size_t index = 0; index < Context.DirtyRects.size();) {
+		if (Context.DirtyRects[index].Overlaps(Rect)) {
+			Rect = Rect.Union(Context.DirtyRects[index]);
+
+			Context.DirtyRects.erase(Context.DirtyRects.begin() + static_cast<ptrdiff_t>(index));
+			index = 0;
+		} else {
+			++index;
+		}
+	}
+
+	if (Context.DirtyRects.size() >= MaxDirtyRects) {
+		for (auto &dirty : Context.DirtyRects) {
+			Rect = Rect.Union(dirty);
+		}
+		Context.DirtyRects.clear();
+	}
+
+	Context.DirtyRects.push_back(Rect);
+}
+
+void _TrackDamage(HXRuntimeContext &Context) {
+	for (size_t index = 0; index < Context.Windows.size(); ++index) {
+		auto      *window = Context.Windows[index];
+		const auto rect   = HXRect{window->Where.X, window->Where.Y, window->Where.X + window->PainterSize.X,
+		                           window->Where.Y + window->PainterSize.Y};
+
+		const bool moved    = !window->Presented || window->PresentedRect != rect;
+		const bool changed  = !window->ContentValid || window->ContentHash != window->DrawList.Hash() ||
+		                      window->PresentedOpacity != window->Opacity;
+		const bool restack  = index >= Context.PresentedWindows.size() || Context.PresentedWindows[index] != window;
+		if (moved) {
+			_AddDirtyRect(Context, window->PresentedRect);
+			_AddDirtyRect(Context, rect);
+		} else if (changed || restack) {
+			_AddDirtyRect(Context, rect);
+		}
+	}
+
+	// The windows presented last time but not submitted in this frame leave
+	// holes on the target
+	for (auto &window : Context.PresentedWindows) {
+		if (window->LastFrame != Context.Frame && window->Presented) {
+			_AddDirtyRect(Context, window->PresentedRect);
+
+			window->Presented = false;
+		}
+	}
+}
+
+/**
+ * Building the hit-test index from the layout of this frame, which will be
+ * used to route the messages of the next frame
+ */
+void _BuildHitIndex(HXRuntimeContext &Context) {
+	Context.WindowGrid.Reset();
+	Context.HitWindows = Context.Windows;
+	for (size_t index = 0; index < Context.HitWindows.size(); ++index) {
+		auto *window = Context.HitWindows[index];
+		Context.WindowGrid.Insert({window->Where.X, window->Where.Y, window->Where.X + window->PainterSize.X,
+		                           window->Where.Y + window->PainterSize.Y},
+		                          static_cast<uint32_t>(index));
+
+		window->ControlGrid.Reset();
+		for (size_t control = 0; control < window->ControlRects.size(); ++control) {
+			window->ControlGrid.Insert(window->ControlRects[control], static_cast<uint32_t>(control));
+		}
+		window->ControlGrid.Build();
+	}
+	Context.WindowGrid.Build();
+}
+
+HXFrameArena &GetFrameArena() {
+	return GetContext().FrameArena;
+}
+
+HXMessageQueueStats GetMessageStats() {
+	auto &context = GetContext();
+
+	auto stats = context.MessageQuery.Stats();
+	stats.Dropped += context.InputDropped.load(std::memory_order_relaxed);
+
+	return stats;
+}
+
+void SetProfiling(bool Enable) {
+	GetContext().Profiler.SetEnabled(Enable);
+}
+
+HXProfiler &GetProfiler() {
+	return GetContext().Profiler;
+}
+
+const HXFrameStats &GetFrameStats() {
+	return GetContext().Profiler.Stats();
+}
+
+const HXMemoryStats &GetFrameMemory() {
+	return GetContext().FrameMemory;
+}
+
+void SetAllocationGuard(HXAllocationGuard Mode) {
+	auto &context = GetContext();
+
+	// A guard armed by the frame running now is dropped with it
+	HXArmAllocationGuard(HXAllocationGuard::Off);
+
+	context.AllocationGuard = Mode;
+	context.MemorySteady    = false;
+}
+
+uint64_t GetAllocationViolations() {
+	return GetContext().AllocationViolations;
+}
+
+bool ExportTrace(const std::filesystem::path &Path) {
+	std::ofstream stream(Path, std::ios::binary);
+	if (!stream) {
+		return false;
+	}
+
+	GetContext().Profiler.ExportChromeTrace(stream);
+
+	return stream.good();
+}
+
+/**
+ * Sorting the messages not taken by the controls of a window by the order
+ * of the controls, the messages of one control keep their order. It is a
+ * counting sort whose buffers come from the frame arena
+ */
+void _SortControlInbox(HXRuntimeContext &Context, HXWindow *Window) {
+	auto *const  messages = Window->ControlInbox.data() + Window->ControlCursor;
+	const size_t count    = Window->ControlInbox.size() - Window->ControlCursor;
+	if (count < 2) {
+		return;
+	}
+
+	uint32_t controls = 0;
+	for (size_t index = 0; index < count; ++index) {
+		controls = std::max(controls, messages[index].Control + 1);
+	}
+
+	auto offsets = Context.FrameArena.Allocate<uint32_t>(controls + 1);
+	auto sorted  = Context.FrameArena.Allocate<HXRoutedMessage>(count);
+	for (size_t index = 0; index < count; ++index) {
+		++offsets[messages[index].Control + 1];
+	}
+	for (uint32_t control = 0; control < controls; ++control) {
+		offsets[control + 1] += offsets[control];
+	}
+	for (size_t index = 0; index < count; ++index) {
+		sorted[offsets[messages[index].Control]++] = messages[index];
+	}
+
+	std::copy(sorted, sorted + count, messages);
+}
+
+void RouteMessages() {
+	auto &context = GetContext();
+
+	// The messages pushed between HX::Begin and the first window still
+	// belong to this frame, the later ones are left to the next frame
+	if (context.Windows.empty()) {
+		_DrainInput(context);
 	}
+
+	if (context.RoutedMessages >= context.MessageQuery.Size()) {
+		return;
+	}
+
+	HX_PROFILE_SCOPE(context.Profiler, "RouteMessages", context.Frame);
+
+	HXWindow *captured = nullptr;
+	for (auto &window : context.HitWindows) {
+		if (window->Captured) {
+			captured = window;
+			break;
+		}
+	}
+
+	for (size_t index = context.RoutedMessages; index < context.MessageQuery.Size(); ++index) {
+		const auto &message = context.MessageQuery[index];
+		if (!message.MouseAction) {
+			continue;
+		}
+
+		const auto messageIndex  = static_cast<uint32_t>(index);
+		context.LastMouseMessage = messageIndex;
+		if (captured != nullptr) {
+			captured->Inbox.push_back(messageIndex);
+			continue;
+		}
+
+		HXWindow  *target = nullptr;
+		const auto hit    = context.WindowGrid.Find({message.MouseX, message.MouseY});
+		if (hit != HXHitGrid::NoHit) {
+			target = context.HitWindows[hit];
+			target->Inbox.push_back(messageIndex);
+
+			const auto control = target->ControlGrid.Find(
+				{message.MouseX - target->Where.X, message.MouseY - target->Where.Y});
+			if (control != HXHitGrid::NoHit) {
+				target->ControlInbox.push_back({.Control = control, .Message = messageIndex});
+			}
+		}
+
+		for (auto &window : context.HitWindows) {
+			if (window->Tracking && window != target) {
+				window->Inbox.push_back(messageIndex);
+			}
+		}
+	}
+	context.RoutedMessages = context.MessageQuery.Size();
+	context.MessageQuery.Seal();
+
+	// The controls take their messages in the order they are registered
+	for (auto &window : context.HitWindows) {
+		_SortControlInbox(context, window);
+	}
+}
+
+std::span<const HXRoutedMessage> ControlMessages(HXRect Rect) {
+	auto &context = GetContext();
+
+	auto      *window  = context.CurrentWindow;
+	const auto control = static_cast<uint32_t>(window->ControlRects.size());
+
+	// Only the visible part of the control is hit-tested, a control entirely
+	// outside keeps its order but never gets into the grid
+	const auto &clip = window->ClipRect;
+	window->ControlRects.push_back(Rect.Intersect({clip.Left, clip.Top, clip.Right - 1, clip.Bottom - 1}));
+
+	auto &inbox  = window->ControlInbox;
+	auto &cursor = window->ControlCursor;
+	while (cursor < inbox.size() && inbox[cursor].Control < control) {
+		++cursor;
+	}
+
+	const auto begin = cursor;
+	while (cursor < inbox.size() && inbox[cursor].Control == control) {
+		++cursor;
+	}
+
+	return {inbox.data() + begin, cursor - begin};
+}
+
+bool IsVisible(HXRect Rect) {
+	const auto &clip = GetContext().CurrentWindow->ClipRect;
+
+	return Rect.Left < clip.Right && clip.Left <= Rect.Right && Rect.Top < clip.Bottom && clip.Top <= Rect.Bottom;
+}
+
+void PushID(HXLabel Label) {
+	auto &context = GetContext();
+
+	context.IDStack.push_back(GetID(Label));
+}
+
+void PushID(int64_t Index) {
+	auto &context = GetContext();
+
+	const auto parent = context.IDStack.empty() ? HXHashSeed : context.IDStack.back();
+	const auto id     = HXHashCombine(parent, static_cast<uint64_t>(Index));
+	context.IDStack.push_back(id != HXNoID ? id : 1);
+}
+
+void PopID() {
+	auto &context = GetContext();
+
+	// The bottom identity belongs to the window and is never popped
+	if (context.IDStack.size() <= 1) {
+		context.Win       = false;
+		context.LastError = "PopID is called without PushID";
+
+		return;
+	}
+
+	context.IDStack.pop_back();
+}
+
+HXID GetID(HXLabel Label) {
+	auto &context = GetContext();
+
+	return HXMakeID(context.IDStack.empty() ? HXHashSeed : context.IDStack.back(), Label);
 }
 
 void WindowLocate(HXPoint Where) {
-	Context.CurrentWindow->Where = Where;
+	GetContext().CurrentWindow->Where = Where;
 }
 
 void End() {
-	Context.Initialized = false;
+	auto &context = GetContext();
+
+	context.Initialized = false;
+
+	context.Profiler.Close();
+	HX_PROFILE_SCOPE(context.Profiler, "End", context.Frame);
+
+	_TrackDamage(context);
+
+	// A frame handling input may change the layout of the next one, like a
+	// window folded by a click, so the UI only settles after a quiet frame
+	context.Active = context.MessageQuery.Size() != 0 || context.FullDamage || !context.DirtyRects.empty();
+
+	auto &stats      = context.Profiler.Stats();
+	stats.Messages   = static_cast<uint32_t>(context.MessageQuery.Size());
+	stats.LayoutTime = context.Profiler.Now() - stats.Start;
+
+	if (context.IDStack.size() > 1) {
+		context.Win       = false;
+		context.LastError = "PopID is needed for every PushID";
+	}
+	if (!context.LayoutStack.empty()) {
+		context.Win       = false;
+		context.LastError = "EndLayout is needed for every layout";
+
+		context.LayoutStack.clear();
+		context.LayoutTracks.clear();
+	}
+	if (!context.ScrollStack.empty()) {
+		context.Win       = false;
+		context.LastError = "EndScroll is needed for every BeginScroll";
+
+		context.ScrollStack.clear();
+	}
+
+	// The widgets not seen in this frame drop their states, the windows keep
+	// theirs as long as the pooled windows are kept
+	context.ButtonStates.Collect(context.Frame);
+	context.ScrollStates.Collect(context.Frame);
+	context.LayoutStates.Collect(context.Frame);
+	context.WindowStates.Collect(context.Frame > WindowRetainFrames ? context.Frame - WindowRetainFrames : 0);
+
+	for (auto window = context.WindowPool.begin(); window != context.WindowPool.end();) {
+		if (window->second->LastFrame + WindowRetainFrames < context.Frame) {
+			std::erase(context.PresentedWindows, window->second);
+
+			delete window->second;
+			window = context.WindowPool.erase(window);
+		} else {
+			++window;
+		}
+	}
+
+	_BuildHitIndex(context);
 }
 
 bool Wined() {
-	return Context.Win;
+	return GetContext().Win;
 }
 
 void CreateTheme() {
-	Theme = HXTheme{
-		.WindowBackground = HXColor{21, 22, 23, 255},
-		.WindowTitleText = HXColor{255, 255, 255, 255},
-		.WindowTitleBackground = HXColor{41, 74, 122, 255},
-		.ButtonBorder = HXColor{39, 73, 114, 255},
-		.ButtonBackground = HXColor{39, 73, 114, 255},
-		.ButtonText = HXColor{255, 255, 255, 255},
-		.ButtonOnHoverBorder = HXColor{49, 83, 124, 255},
-		.ButtonOnHoverBackground = HXColor{49, 83, 124, 255},
-		.ButtonOnHoverText = HXColor{255, 255, 255, 255},
-		.ButtonPressedBorder = HXColor{59, 93, 134, 255},
-		.ButtonPressedBackground = HXColor{59, 93, 134, 255},
-		.ButtonPressedText = HXColor{255, 255, 255, 255},
+	GetContext().Theme = _DefaultTheme();
+}
+
+/**
+ * Arming the allocation guard of a steady frame for the task running in
+ * its scope, the guard is per thread so the pool threads have to arm it
+ * themselves. A thread already guarding the frame is left as it is
+ */
+class _TaskGuard {
+public:
+	explicit _TaskGuard(HXRuntimeContext &Context) : _context(Context) {
+		if (Context.MemorySteady && Context.AllocationGuard != HXAllocationGuard::Off) {
+			_guarded  = HXGuardedAllocations();
+			_previous = HXArmAllocationGuard(Context.AllocationGuard);
+			_armed    = true;
+		}
+	}
+
+	~_TaskGuard() {
+		if (!_armed) {
+			return;
+		}
+
+		HXArmAllocationGuard(_previous);
+		if (_previous == HXAllocationGuard::Off) {
+			_context.TaskGuarded.fetch_add(HXGuardedAllocations() - _guarded, std::memory_order_relaxed);
+		}
+	}
+
+	_TaskGuard(const _TaskGuard &) = delete;
+
+	_TaskGuard &operator=(const _TaskGuard &) = delete;
+
+private:
+	HXRuntimeContext &_context;
+	HXAllocationGuard _previous = HXAllocationGuard::Off;
+	uint64_t          _guarded  = 0;
+	bool              _armed    = false;
+};
+
+/**
+ * Replaying the recorded commands of a window onto its painter
+ */
+void _ReplayWindow(void *Window) {
+	auto window = static_cast<HXWindow *>(Window);
+
+	_TaskGuard guard(*window->Context);
+
+	HX_PROFILE_SCOPE(window->Context->Profiler, "Replay", window->LastFrame, window->Title);
+
+	window->Painter->Begin();
+	window->DrawList.Replay(window->Painter);
+	window->Painter->End();
+
+	window->ContentHash  = window->DrawList.Hash();
+	window->ContentValid = true;
+}
+
+void _WaitWindow(HXWindow *Window) {
+	if (Window->Replay.Pending.load(std::memory_order_acquire) != 0) {
+		GetThreadPool().Wait(Window->Replay);
+	}
+}
+
+HXRect _WindowRect(const HXWindow *Window) {
+	return {Window->Where.X, Window->Where.Y, Window->Where.X + Window->PainterSize.X,
+	        Window->Where.Y + Window->PainterSize.Y};
+}
+
+/**
+ * Compositing the windows overlapping a tile onto the target, from the
+ * bottom window to the top one
+ */
+void _CompositeTile(void *Tile) {
+	const auto &tile    = *static_cast<HXCompositeTile *>(Tile);
+	auto       &windows = tile.Context->Windows;
+
+	_TaskGuard guard(*tile.Context);
+
+	HX_PROFILE_SCOPE(tile.Context->Profiler, "CompositeTile", tile.Context->Frame);
+	for (auto window = windows.rbegin(); window != windows.rend(); ++window) {
+		if (!tile.Rect.Overlaps(_WindowRect(*window))) {
+			continue;
+		}
+
+		_WaitWindow(*window);
+		tile.Context->TargetPainter->DrawPainterRegion((*window)->Painter, (*window)->Where, tile.Rect,
+		                                               (*window)->Opacity);
+	}
+}
+
+/**
+ * Splitting the damaged regions into tiles and compositing them on the
+ * thread pool, the tiles are aligned to a fixed grid and clipped by the
+ * regions, so no two tiles write the same pixel
+ */
+void _CompositeTiles(HXRuntimeContext &Context) {
+	Context.Tiles.clear();
+
+	auto addRegion = [&Context](HXRect Region) {
+		const HXGInt left = Region.Left - (Region.Left % CompositeTileSize + CompositeTileSize) % CompositeTileSize;
+		const HXGInt top  = Region.Top - (Region.Top % CompositeTileSize + CompositeTileSize) % CompositeTileSize;
+		for (HXGInt y = top; y < Region.Bottom; y += CompositeTileSize) {
+			for (HXGInt x = left; x < Region.Right; x += CompositeTileSize) {
+				const auto rect = Region.Intersect({x, y, x + CompositeTileSize, y + CompositeTileSize});
+				if (!rect.IsEmpty()) {
+					Context.Tiles.push_back({.Context = &Context, .Rect = rect});
+				}
+			}
+		}
 	};
+
+	if (Context.FullDamage) {
+		if (Context.Windows.empty()) {
+			return;
+		}
+
+		auto bounds = _WindowRect(Context.Windows.front());
+		for (auto &window : Context.Windows) {
+			bounds = bounds.Union(_WindowRect(window));
+		}
+		addRegion(bounds);
+	} else {
+		for (auto &dirty : Context.DirtyRects) {
+			addRegion(dirty);
+		}
+	}
+
+	// The tiles are only submitted once the list stops growing, since the
+	// tasks point into it
+	Context.Profiler.Stats().CompositeTiles += static_cast<uint32_t>(Context.Tiles.size());
+
+	auto &pool = GetThreadPool();
+	for (auto &tile : Context.Tiles) {
+		pool.Submit(Context.Composite, _CompositeTile, &tile);
+	}
+	pool.Wait(Context.Composite);
+}
+
+void _AccountFrameMemory(HXRuntimeContext &Context) {
+	Context.FrameMemory = HXGetMemoryStats().Delta(Context.FrameMemoryStart);
+
+	const auto total = Context.FrameMemory.Total();
+	auto      &stats = Context.Profiler.Stats();
+	stats.Allocations    = static_cast<uint32_t>(total.Allocations);
+	stats.AllocatedBytes = total.Bytes;
+
+	if (!Context.MemorySteady) {
+		Context.MemorySteady = total.Allocations == 0;
+
+		return;
+	}
+	if (Context.AllocationGuard == HXAllocationGuard::Off) {
+		return;
+	}
+
+	HXArmAllocationGuard(HXAllocationGuard::Off);
+	const auto taskGuarded = Context.TaskGuarded.exchange(0, std::memory_order_relaxed);
+	if (HXGuardedAllocations() != Context.GuardedAtBegin || taskGuarded != 0) {
+		++Context.AllocationViolations;
+		Context.LastError = "Allocated in a steady frame";
+	}
 }
 
 void Render() {
-	HXBufferPainter *Painter = Context.RenderContext->DefaultPainter()->CreateFromBuffer(Context.LocalBuffer);
-	for (auto window = Context.Windows.rbegin(); window != Context.Windows.rend(); ++window) {
-		Painter->DrawPainter((*window)->Painter, (*window)->Where);
+	auto &context = GetContext();
+	auto &stats   = context.Profiler.Stats();
+	auto  start   = context.Profiler.Now();
+
+	HX_PROFILE_SCOPE(context.Profiler, "Render", context.Frame);
+
+	if (context.TargetPainter == nullptr || context.TargetBuffer != context.LocalBuffer) {
+		delete context.TargetPainter;
+
+		context.TargetPainter = context.RenderContext->DefaultPainter()->CreateFromBuffer(context.LocalBuffer);
+		context.TargetBuffer  = context.LocalBuffer;
+		context.FullDamage    = true;
+	}
+
+	// Every window replays its recorded commands in one pass, so the painter
+	// is only selected once per window, the windows recording the same
+	// commands as the last time keep their pixels and are only composited.
+	// The windows own their painters, so they can be replayed in parallel
+	const bool parallel = context.ParallelRender && context.RenderContext->ParallelPainting();
+	for (auto &window : context.Windows) {
+		if (window->ContentValid && window->ContentHash == window->DrawList.Hash()) {
+			continue;
+		}
+
+		++stats.WindowsReplayed;
+		stats.DrawCommands += static_cast<uint32_t>(window->DrawList.Size());
+		if (parallel) {
+			GetThreadPool().Submit(window->Replay, _ReplayWindow, window);
+		} else {
+			_ReplayWindow(window);
+		}
+	}
+
+	// Only the damaged regions are composited, from the bottom window to
+	// the top one, a window is only waited for when it is composited
+	HX_PROFILE_SCOPE(context.Profiler, "Composite", context.Frame);
+	if (parallel) {
+		_CompositeTiles(context);
+	} else if (context.FullDamage) {
+		for (auto window = context.Windows.rbegin(); window != context.Windows.rend(); ++window) {
+			_WaitWindow(*window);
+			context.TargetPainter->DrawPainterRegion((*window)->Painter, (*window)->Where, _WindowRect(*window),
+			                                         (*window)->Opacity);
+		}
+	} else {
+		for (auto &dirty : context.DirtyRects) {
+			for (auto window = context.Windows.rbegin(); window != context.Windows.rend(); ++window) {
+				if (!dirty.Overlaps(_WindowRect(*window))) {
+					continue;
+				}
+
+				_WaitWindow(*window);
+				context.TargetPainter->DrawPainterRegion((*window)->Painter, (*window)->Where, dirty,
+				                                         (*window)->Opacity);
+			}
+		}
+	}
+
+	// The windows not composited still have to be finished, since the next
+	// frame may resize their painters
+	for (auto &window : context.Windows) {
+		_WaitWindow(window);
+	}
+
+	for (auto &window : context.Windows) {
+		window->PresentedRect    = _WindowRect(window);
+		window->PresentedOpacity = window->Opacity;
+		window->Presented        = true;
+	}
+	context.PresentedWindows = context.Windows;
+	context.DirtyRects.clear();
+	context.FullDamage = false;
+
+	stats.RenderTime += context.Profiler.Now() - start;
+
+	_AccountFrameMemory(context);
+}
+
+bool NeedsFrame() {
+	auto &context = GetContext();
+
+	return context.Active || context.FullDamage || !context.InputQueue.Empty() ||
+	       context.FrameDeadline <= std::chrono::steady_clock::now();
+}
+
+void RequestFrame(uint32_t Milliseconds) {
+	auto &context = GetContext();
+
+	context.FrameDeadline = std::min(context.FrameDeadline,
+	                                 std::chrono::steady_clock::now() + std::chrono::milliseconds(Milliseconds));
+}
+
+bool WaitForEvents(uint32_t Milliseconds) {
+	auto &context = GetContext();
+	if (NeedsFrame()) {
+		return true;
+	}
+
+	// The wait ends with the timeout or the requested frame, whichever is
+	// earlier
+	auto deadline = context.FrameDeadline;
+	if (Milliseconds != UINT32_MAX) {
+		deadline = std::min(deadline, std::chrono::steady_clock::now() + std::chrono::milliseconds(Milliseconds));
+	}
+
+	// The thread sleeps on the signal of the pushed messages, so a message
+	// pushed by another thread wakes it at once. The implementations taking
+	// their input from the OS can only peek it, so the OS is peeked between
+	// the slices of the sleep
+	constexpr auto pollInterval = std::chrono::milliseconds(8);
+
+	bool pollOS  = context.OSAPI != nullptr;
+	bool osInput = false;
+
+	auto pushed = [&context] {
+		return !context.InputQueue.Empty();
+	};
+
+	std::unique_lock lock(context.WakeLock);
+	context.Sleeping.store(true, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	while (!pushed()) {
+		if (pollOS) {
+			const auto result = context.OSAPI->PeekInput();
+			if (result == HXPeekResult::Input) {
+				osInput = true;
+
+				break;
+			}
+			pollOS = result != HXPeekResult::Unsupported;
+		}
+
+		const auto now = std::chrono::steady_clock::now();
+		if (now >= deadline) {
+			break;
+		}
+
+		if (pollOS) {
+			context.WakeSignal.wait_until(lock, std::min(deadline, now + pollInterval), pushed);
+		} else if (deadline == std::chrono::steady_clock::time_point::max()) {
+			context.WakeSignal.wait(lock, pushed);
+		} else {
+			context.WakeSignal.wait_until(lock, deadline, pushed);
+		}
+	}
+	context.Sleeping.store(false, std::memory_order_relaxed);
+
+	return osInput || NeedsFrame();
+}
+
+void SetParallelRender(bool Enable) {
+	GetContext().ParallelRender = Enable;
+}
+
+HXThreadPool &GetThreadPool() {
+	static HXThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+	return pool;
+}
+
+void Invalidate() {
+	auto &context = GetContext();
+
+	context.FullDamage = true;
+	context.DirtyRects.clear();
+}
+
+bool IsFullyDamaged() {
+	return GetContext().FullDamage;
+}
+
+const HXVector<HXRect, HXMemoryTag::Painter> &GetDirtyRects() {
+	return GetContext().DirtyRects;
+}
+
+HXRect GetDirtyBounds() {
+	auto &context = GetContext();
+
+	if (context.DirtyRects.empty()) {
+		return {0, 0, 0, 0};
+	}
+
+	auto bounds = context.DirtyRects.front();
+	for (auto &dirty : context.DirtyRects) {
+		bounds = bounds.Union(dirty);
 	}
+
+	return bounds;
+}
+
+HXRect MeasureText(HXStringView Text, HXFontHandle Font, HXGUInt Height) {
+	auto &context = GetContext();
+
+	++context.Profiler.Stats().TextMeasures;
+
+	auto painter = context.CurrentWindow != nullptr && context.CurrentWindow->Painter != nullptr
+		               ? context.CurrentWindow->Painter
+		               : context.RenderContext->DefaultPainter();
+
+	// A hit of the cache is too short to be worth a span, and a frame with
+	// thousands of texts would push the frame spans out of the ring, so
+	// only the measurements asking the painter are recorded
+	auto      &profiler = context.Profiler;
+	const bool profiled = profiler.Enabled();
+	const auto begin    = profiled ? profiler.Now() : 0;
+	const auto misses   = context.MeasureCache.Stats().Misses;
+	const auto result   = context.MeasureCache.Measure(painter, Text, Font, Height);
+	if (profiled && context.MeasureCache.Stats().Misses != misses) {
+		profiler.Record("MeasureText", Text, context.Frame, begin, profiler.Now());
+	}
+
+	return result;
+}
+
+const HXMeasureCacheStats &GetMeasureStats() {
+	return GetContext().MeasureCache.Stats();
 }
 
 HXPoint ClipCoord(HXPoint Point) {
-	return { Point.X - Context.CurrentWindow->Where.X, Point.Y - Context.CurrentWindow->Where.Y };
+	auto &context = GetContext();
+
+	return { Point.X - context.CurrentWindow->Where.X, Point.Y - context.CurrentWindow->Where.Y };
 }
 
 }
+
+HXRuntimeContext::~HXRuntimeContext() {
+	for (auto &[id, window] : WindowPool) {
+		delete window;
+	}
+
+	delete TargetPainter;
+}
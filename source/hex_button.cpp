@@ -29,86 +29,91 @@
 #include <include/hex_button.h>
 
 namespace HX {
-bool Button(const HXString &Title, ButtonProfile &Profile) {
+bool Button(HXStringView Title, ButtonProfile &Profile) {
 	auto &context = GetContext();
 	auto &theme   = GetTheme();
 
-	constexpr HXGInt ControlGap = 5;
-
 	if (context.CurrentWindow->Folded) {
 		return false;
 	}
 
-	const auto fontRect = context.CurrentWindow->Painter->MeasureText(Title, HXFont{}, 18);
+	const auto fontRect = MeasureText(Title, HXFontHandle{}, 18);
 
-	constexpr HXGInt leftGap    = 10;
 	constexpr HXGInt contentGap = 10;
 
-	const auto buttonRectangle = HXRect{leftGap, context.CurrentWindow->BaseLine,
-	                                    leftGap + fontRect.Right + contentGap,
-	                                    context.CurrentWindow->BaseLine + contentGap + fontRect.
-	                                    Bottom};
+	const auto buttonRectangle = PlaceControl({fontRect.Right + contentGap, fontRect.Bottom + contentGap});
 
 	bool pressed = false;
 
-	// Process the presse or hover
-	for (auto &Message : context.MessageQuery) {
-		auto mouse = ClipCoord({Message.MouseX, Message.MouseY});
+	// Process the presse or hover, only the messages routed to the button
+	// are looked at
+	uint32_t lastMessage = HXNoMessage;
+	for (auto &routed : ControlMessages(buttonRectangle)) {
+		auto &Message = context.MessageQuery[routed.Message];
+		auto  mouse   = ClipCoord({Message.MouseX, Message.MouseY});
 		if (Message.Processed) {
 			continue;
 		}
-		if (Message.MouseAction) {
-			if (mouse.X >= buttonRectangle.Left && mouse.X <= buttonRectangle.Right &&
-			    mouse.Y >= buttonRectangle.Top && mouse.Y <= buttonRectangle.Bottom) {
-				Message.Processed = true;
-
-				Profile.OnHover = true;
-				if (Message.MouseLeftPressed) {
-					Profile.OnHold = true;
-				}
-				if (Message.MouseLeftRelease) {
-					Profile.OnHold = false;
-
-					pressed = true;
-				}
-			} else {
-				Profile.OnHover = false;
-				Profile.OnHold  = false;
+
+		lastMessage = routed.Message;
+
+		// The message is routed with the layout of the last frame, which
+		// may be different from the one of this frame
+		if (mouse.X >= buttonRectangle.Left && mouse.X <= buttonRectangle.Right &&
+		    mouse.Y >= buttonRectangle.Top && mouse.Y <= buttonRectangle.Bottom) {
+			// A wheel message only hovers the button, the scroll region
+			// around it still takes it
+			Message.Processed = Message.MouseWheel == 0;
+
+			Profile.OnHover = true;
+			if (Message.MouseLeftPressed) {
+				Profile.OnHold = true;
+			}
+			if (Message.MouseLeftRelease) {
+				Profile.OnHold = false;
+
+				pressed = true;
 			}
+		} else {
+			Profile.OnHover = false;
+			Profile.OnHold  = false;
 		}
 	}
 
-	context.CurrentWindow->Painter->Begin();
+	// The mouse has left the button when the last mouse message went to
+	// somewhere else
+	if (context.LastMouseMessage != HXNoMessage && context.LastMouseMessage != lastMessage) {
+		Profile.OnHover = false;
+		Profile.OnHold  = false;
+	}
+
+	Profile.OnPressed = pressed;
+
+	// A button scrolled out of sight is only laid out
+	if (!IsVisible(buttonRectangle)) {
+		return pressed;
+	}
+
+	auto      &drawList  = context.CurrentWindow->DrawList;
+	const auto textWhere = HXPoint{buttonRectangle.Left + contentGap / 2, buttonRectangle.Top + contentGap / 2};
 
 	if (Profile.OnHold) {
-		context.CurrentWindow->Painter->DrawFilledRectangle(buttonRectangle, theme.ButtonPressedBorder,
-		                                                    theme.ButtonPressedBackground);
-		context.CurrentWindow->Painter->DrawText(Title, HXFont{},
-		                                         {leftGap + contentGap / 2,
-		                                          context.CurrentWindow->BaseLine + contentGap / 2},
-		                                         theme.ButtonPressedText, 18);
+		drawList.AddFilledRectangle(buttonRectangle, theme.ButtonPressedBorder, theme.ButtonPressedBackground);
+		drawList.AddText(Title, HXFontHandle{}, textWhere, theme.ButtonPressedText, 18);
 	} else if (Profile.OnHover) {
-		context.CurrentWindow->Painter->DrawFilledRectangle(buttonRectangle, theme.ButtonOnHoverBorder,
-		                                                    theme.ButtonOnHoverBackground);
-		context.CurrentWindow->Painter->DrawText(Title, HXFont{},
-		                                         {leftGap + contentGap / 2,
-		                                          context.CurrentWindow->BaseLine + contentGap / 2},
-		                                         theme.ButtonOnHoverText, 18);
+		drawList.AddFilledRectangle(buttonRectangle, theme.ButtonOnHoverBorder, theme.ButtonOnHoverBackground);
+		drawList.AddText(Title, HXFontHandle{}, textWhere, theme.ButtonOnHoverText, 18);
 	} else {
-		context.CurrentWindow->Painter->
-			DrawFilledRectangle(buttonRectangle, theme.ButtonBorder, theme.ButtonBackground);
-		context.CurrentWindow->Painter->DrawText(Title, HXFont{},
-		                                         {leftGap + contentGap / 2,
-		                                          context.CurrentWindow->BaseLine + contentGap / 2}, theme.ButtonText,
-		                                         18);
+		drawList.AddFilledRectangle(buttonRectangle, theme.ButtonBorder, theme.ButtonBackground);
+		drawList.AddText(Title, HXFontHandle{}, textWhere, theme.ButtonText, 18);
 	}
 
-	context.CurrentWindow->Painter->End();
-
-	Profile.OnPressed = pressed;
+	return pressed;
+}
 
-	context.CurrentWindow->BaseLine += buttonRectangle.CalHeight() + ControlGap;
+bool Button(HXTitle Title) {
+	auto &context = GetContext();
 
-	return pressed;
+	return Button(Title.Text, context.ButtonStates.Touch(GetID(Title), context.Frame));
+}
 }
-}
\ No newline at end of file
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * \file hex_draw_list.cpp
+ * \brief The recorded draw commands of a window
+ */
+
+#include <include/hex_draw_list.h>
+
+namespace {
+uint64_t _PackColor(HXColor Color) {
+	return static_cast<uint64_t>(Color.R) | static_cast<uint64_t>(Color.G) << 8 | static_cast<uint64_t>(Color.B) << 16 |
+	       static_cast<uint64_t>(Color.A) << 24;
+}
+
+uint64_t _PackPair(HXGInt First, HXGInt Second) {
+	return static_cast<uint32_t>(First) | static_cast<uint64_t>(static_cast<uint32_t>(Second)) << 32;
+}
+}
+
+void HXDrawList::Reset() {
+	_commands.clear();
+	_points.clear();
+	_fonts.clear();
+	_text.clear();
+
+	_hash = HXHashSeed;
+}
+
+size_t HXDrawList::Size() const {
+	return _commands.size();
+}
+
+HXHash HXDrawList::Hash() const {
+	return _hash;
+}
+
+void HXDrawList::HashCommand(const HXDrawCommand &Command) {
+	// The fields are mixed one by one, since the padding of the command
+	// structure is not guaranteed to be initialized
+	_hash = HXHashCombine(_hash, static_cast<uint64_t>(Command.Type) | _PackColor(Command.Color) << 8);
+	_hash = HXHashCombine(_hash, _PackColor(Command.FillColor) | static_cast<uint64_t>(Command.Extra) << 32);
+	_hash = HXHashCombine(_hash, _PackPair(Command.Rect.Left, Command.Rect.Top));
+	_hash = HXHashCombine(_hash, _PackPair(Command.Rect.Right, Command.Rect.Bottom));
+	_hash = HXHashCombine(_hash, Command.Count);
+}
+
+void HXDrawList::Replay(HXBufferPainter *Painter) const {
+	for (auto &command : _commands) {
+		switch (command.Type) {
+		case HXDrawCommandType::Clear:
+			Painter->Clear(command.Color);
+			break;
+		case HXDrawCommandType::Line:
+			Painter->DrawLine({command.Rect.Left, command.Rect.Top}, {command.Rect.Right, command.Rect.Bottom},
+			                  command.Color);
+			break;
+		case HXDrawCommandType::Rectangle:
+			Painter->DrawRectangle(command.Rect, command.Color);
+			break;
+		case HXDrawCommandType::FilledRectangle:
+			Painter->DrawFilledRectangle(command.Rect, command.Color, command.FillColor);
+			break;
+		case HXDrawCommandType::FilledRoundedRectangle:
+			Painter->DrawFilledRoundedRectangle(command.Rect, command.Color, command.FillColor, command.Extra);
+			break;
+		case HXDrawCommandType::FilledPolygon:
+			Painter->DrawFilledPolygon(_points.data() + command.Offset, command.Count, command.Color);
+			break;
+		case HXDrawCommandType::Text:
+			Painter->DrawText(HXStringView(_text).substr(command.Offset, command.Count), _fonts[command.Font],
+			                  {command.Rect.Left, command.Rect.Top}, command.Color, static_cast<HXGUInt>(command.Extra));
+			break;
+		case HXDrawCommandType::Clip:
+			Painter->SetClipRect(command.Rect);
+			break;
+		}
+	}
+
+	Painter->ResetClipRect();
+}
+
+void HXDrawList::AddClear(HXColor Color) {
+	_commands.push_back({.Type = HXDrawCommandType::Clear, .Color = Color});
+	HashCommand(_commands.back());
+}
+
+void HXDrawList::AddLine(HXPoint Point1, HXPoint Point2, HXColor Color) {
+	_commands.push_back(
+		{.Type = HXDrawCommandType::Line, .Color = Color, .Rect = {Point1.X, Point1.Y, Point2.X, Point2.Y}});
+	HashCommand(_commands.back());
+}
+
+void HXDrawList::AddRectangle(HXRect Rect, HXColor Color) {
+	_commands.push_back({.Type = HXDrawCommandType::Rectangle, .Color = Color, .Rect = Rect});
+	HashCommand(_commands.back());
+}
+
+void HXDrawList::AddFilledRectangle(HXRect Rect, HXColor Color, HXColor FillColor) {
+	_commands.push_back(
+		{.Type = HXDrawCommandType::FilledRectangle, .Color = Color, .FillColor = FillColor, .Rect = Rect});
+	HashCommand(_commands.back());
+}
+
+void HXDrawList::AddFilledRoundedRectangle(HXRect Rect, HXColor Color, HXColor FillColor, HXGInt Radius) {
+	_commands.push_back({.Type      = HXDrawCommandType::FilledRoundedRectangle,
+	                     .Color     = Color,
+	                     .FillColor = FillColor,
+	                     .Rect      = Rect,
+	                     .Extra     = Radius});
+	HashCommand(_commands.back());
+}
+
+void HXDrawList::AddFilledPolygon(const HXPoint *Points, size_t Count, HXColor Color) {
+	_commands.push_back({.Type   = HXDrawCommandType::FilledPolygon,
+	                     .Color  = Color,
+	                     .Offset = static_cast<uint32_t>(_points.size()),
+	                     .Count  = static_cast<uint32_t>(Count)});
+	_points.insert(_points.end(), Points, Points + Count);
+
+	HashCommand(_commands.back());
+	for (size_t index = 0; index < Count; ++index) {
+		_hash = HXHashCombine(_hash, _PackPair(Points[index].X, Points[index].Y));
+	}
+}
+
+void HXDrawList::AddText(HXStringView Text, HXFontHandle Font, HXPoint Where, HXColor Color, HXGUInt Height) {
+	// Consecutive texts usually share the same font, so only a new font
+	// will be appended to the list
+	if (_fonts.empty() || _fonts.back() != Font) {
+		_fonts.push_back(Font);
+
+		_hash = HXHashCombine(_hash, Font.Key());
+	}
+
+	_commands.push_back({.Type   = HXDrawCommandType::Text,
+	                     .Color  = Color,
+	                     .Rect   = {Where.X, Where.Y, Where.X, Where.Y},
+	                     .Extra  = static_cast<HXGInt>(Height),
+	                     .Offset = static_cast<uint32_t>(_text.size()),
+	                     .Count  = static_cast<uint32_t>(Text.size()),
+	                     .Font   = static_cast<uint32_t>(_fonts.size() - 1)});
+	_text.append(Text);
+
+	HashCommand(_commands.back());
+	_hash = HXHashString(Text.data(), Text.size(), _hash);
+}
+
+void HXDrawList::AddClipRect(HXRect Rect) {
+	_commands.push_back({.Type = HXDrawCommandType::Clip, .Rect = Rect});
+	HashCommand(_commands.back());
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_frame_arena.cpp
+ * \brief The bump allocator for the data living in a single frame
+ */
+
+#include <include/hex_frame_arena.h>
+
+#include <algorithm>
+
+HXFrameArena::HXFrameArena(size_t BlockSize) : _blockSize(BlockSize) {
+}
+
+void *HXFrameArena::Allocate(size_t Size, size_t Alignment) {
+	// Walking to the first block with enough room left, the blocks after the
+	// current one are the ones kept from an earlier frame
+	while (_current < _blocks.size()) {
+		auto      &block   = _blocks[_current];
+		const auto base    = reinterpret_cast<uintptr_t>(block.Memory.get());
+		const auto aligned = (base + _offset + Alignment - 1) & ~(static_cast<uintptr_t>(Alignment) - 1);
+		if (aligned + Size <= base + block.Size) {
+			_offset = aligned + Size - base;
+			_stats.Used += Size;
+			_stats.Peak = std::max(_stats.Peak, _stats.Used);
+
+			return reinterpret_cast<void *>(aligned);
+		}
+
+		++_current;
+		_offset = 0;
+	}
+
+	const size_t size = std::max(_blockSize, Size + Alignment);
+	_blocks.push_back({.Memory = HXAllocateArray<std::byte, HXMemoryTag::Arena>(size), .Size = size});
+	_stats.Capacity += size;
+	++_stats.BlockAllocs;
+
+	return Allocate(Size, Alignment);
+}
+
+void HXFrameArena::Reset() {
+	// A frame spilling over several blocks will probably do it again, so
+	// they are replaced by one block holding all of them
+	if (_blocks.size() > 1) {
+		const size_t size = _stats.Capacity;
+
+		_blocks.clear();
+		_blocks.push_back({.Memory = HXAllocateArray<std::byte, HXMemoryTag::Arena>(size), .Size = size});
+		++_stats.BlockAllocs;
+	}
+
+	_current    = 0;
+	_offset     = 0;
+	_stats.Used = 0;
+}
+
+const HXFrameArenaStats &HXFrameArena::Stats() const {
+	return _stats;
+}
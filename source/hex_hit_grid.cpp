@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_hit_grid.cpp
+ * \brief The spatial index for hit-testing
+ */
+
+#include <include/hex_hit_grid.h>
+
+void HXHitGrid::Reset() {
+	_entries.clear();
+	_cellStart.clear();
+	_cellEntries.clear();
+
+	_columns = 0;
+	_rows    = 0;
+}
+
+void HXHitGrid::Insert(HXRect Rect, uint32_t Value) {
+	if (Rect.Right < Rect.Left || Rect.Bottom < Rect.Top) {
+		return;
+	}
+
+	_entries.push_back({.Rect = Rect, .Value = Value});
+}
+
+void HXHitGrid::Build() {
+	_cellStart.clear();
+	_cellEntries.clear();
+	if (_entries.empty()) {
+		_columns = 0;
+		_rows    = 0;
+
+		return;
+	}
+
+	_bounds = _entries.front().Rect;
+	for (auto &entry : _entries) {
+		_bounds.Left   = std::min(_bounds.Left, entry.Rect.Left);
+		_bounds.Top    = std::min(_bounds.Top, entry.Rect.Top);
+		_bounds.Right  = std::max(_bounds.Right, entry.Rect.Right);
+		_bounds.Bottom = std::max(_bounds.Bottom, entry.Rect.Bottom);
+	}
+
+	const HXGInt extent = std::max(_bounds.Right - _bounds.Left, _bounds.Bottom - _bounds.Top) + 1;
+	_cellSize = std::max(MinCellSize, (extent + MaxCells - 1) / MaxCells);
+	_columns  = (_bounds.Right - _bounds.Left) / _cellSize + 1;
+	_rows     = (_bounds.Bottom - _bounds.Top) / _cellSize + 1;
+
+	// Counting the entries of every cell first, so the cells can be packed
+	// into one array without any per cell allocation
+	_cellStart.assign(static_cast<size_t>(_columns) * _rows + 1, 0);
+	for (auto &entry : _entries) {
+		const HXGInt left   = (entry.Rect.Left - _bounds.Left) / _cellSize;
+		const HXGInt right  = (entry.Rect.Right - _bounds.Left) / _cellSize;
+		const HXGInt top    = (entry.Rect.Top - _bounds.Top) / _cellSize;
+		const HXGInt bottom = (entry.Rect.Bottom - _bounds.Top) / _cellSize;
+		for (HXGInt y = top; y <= bottom; ++y) {
+			for (HXGInt x = left; x <= right; ++x) {
+				++_cellStart[static_cast<size_t>(y) * _columns + x + 1];
+			}
+		}
+	}
+	for (size_t index = 1; index < _cellStart.size(); ++index) {
+		_cellStart[index] += _cellStart[index - 1];
+	}
+
+	_cellEntries.resize(_cellStart.back());
+	_cellFill.assign(_cellStart.begin(), _cellStart.end() - 1);
+	for (size_t index = 0; index < _entries.size(); ++index) {
+		const auto  &rect   = _entries[index].Rect;
+		const HXGInt left   = (rect.Left - _bounds.Left) / _cellSize;
+		const HXGInt right  = (rect.Right - _bounds.Left) / _cellSize;
+		const HXGInt top    = (rect.Top - _bounds.Top) / _cellSize;
+		const HXGInt bottom = (rect.Bottom - _bounds.Top) / _cellSize;
+		for (HXGInt y = top; y <= bottom; ++y) {
+			for (HXGInt x = left; x <= right; ++x) {
+				_cellEntries[_cellFill[static_cast<size_t>(y) * _columns + x]++] = static_cast<uint32_t>(index);
+			}
+		}
+	}
+}
+
+uint32_t HXHitGrid::Find(HXPoint Point) const {
+	if (_columns == 0 || Point.X < _bounds.Left || Point.X > _bounds.Right || Point.Y < _bounds.Top ||
+	    Point.Y > _bounds.Bottom) {
+		return NoHit;
+	}
+
+	const size_t cell = static_cast<size_t>((Point.Y - _bounds.Top) / _cellSize) * _columns +
+	                    (Point.X - _bounds.Left) / _cellSize;
+	for (uint32_t index = _cellStart[cell]; index < _cellStart[cell + 1]; ++index) {
+		const auto &entry = _entries[_cellEntries[index]];
+		if (Point.X >= entry.Rect.Left && Point.X <= entry.Rect.Right && Point.Y >= entry.Rect.Top &&
+		    Point.Y <= entry.Rect.Bottom) {
+			return entry.Value;
+		}
+	}
+
+	return NoHit;
+}
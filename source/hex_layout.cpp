@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_layout.cpp
+ * \brief The layout of the widgets for HiEasyX
+ */
+
+#include <include/hex.h>
+#include <include/hex_layout.h>
+
+#include <algorithm>
+
+namespace HX {
+namespace {
+// The margins of the widgets placed in the window without a layout
+constexpr HXGInt WindowMargin = 10;
+constexpr HXGInt ControlGap   = 5;
+
+/**
+ * Hashing the inputs the cells of a layout are solved from, the measured
+ * size only matters for the auto cells
+ */
+HXHash _HashInputs(HXLayoutAxis Axis, std::span<const LayoutSize> Cells, size_t Count, HXGInt Available,
+                   HXGInt Gap, const HXLayoutCache &Cache) {
+	HXHash hash = HXHashCombine(HXHashSeed, static_cast<uint64_t>(Axis));
+	hash        = HXHashCombine(hash, static_cast<uint32_t>(Available) | static_cast<uint64_t>(Gap) << 32);
+	for (size_t index = 0; index < Count; ++index) {
+		const auto &cell     = Cells[index % Cells.size()];
+		const auto  measured = cell.Mode == SizeMode::Auto ? Cache.Tracks[index].Measured : 0;
+
+		hash = HXHashCombine(hash, static_cast<uint64_t>(cell.Mode) | static_cast<uint64_t>(
+			                           static_cast<uint32_t>(cell.Value)) << 8);
+		hash = HXHashCombine(hash, static_cast<uint32_t>(measured));
+	}
+
+	return hash;
+}
+
+/**
+ * Solving the cells of a layout, the fixed and the auto cells take their
+ * sizes first and the flexible cells share what is left by their weights
+ */
+void _Solve(std::span<const LayoutSize> Cells, size_t Count, HXGInt Available, HXGInt Gap, HXLayoutCache &Cache) {
+	HXGInt used   = Gap * static_cast<HXGInt>(Count > 0 ? Count - 1 : 0);
+	HXGInt weight = 0;
+	for (size_t index = 0; index < Count; ++index) {
+		const auto &cell  = Cells[index % Cells.size()];
+		auto       &track = Cache.Tracks[index];
+
+		track.Mode = cell.Mode;
+		switch (cell.Mode) {
+		case SizeMode::Auto:
+			track.Size = track.Measured;
+			break;
+		case SizeMode::Fixed:
+			track.Size = std::max<HXGInt>(cell.Value, 0);
+			break;
+		case SizeMode::Flex:
+			track.Size = 0;
+			weight += std::max<HXGInt>(cell.Value, 1);
+			break;
+		}
+		used += track.Size;
+	}
+
+	// The last flexible cell takes the rounding left by the others, so the
+	// cells fill the space exactly
+	HXGInt left   = std::max<HXGInt>(Available - used, 0);
+	HXGInt offset = 0;
+	for (size_t index = 0; index < Count; ++index) {
+		auto &track = Cache.Tracks[index];
+		if (track.Mode == SizeMode::Flex) {
+			const HXGInt share = std::max<HXGInt>(Cells[index % Cells.size()].Value, 1);
+
+			track.Size = static_cast<HXGInt>(static_cast<int64_t>(left) * share / weight);
+			left -= track.Size;
+			weight -= share;
+		}
+
+		track.Offset = offset;
+		offset += track.Size + Gap;
+	}
+}
+
+void _BeginLayout(HXLabel Label, HXLayoutAxis Axis, std::span<const LayoutSize> Cells, size_t Count, HXGInt Gap) {
+	auto &context = GetContext();
+
+	const auto id        = GetID(Label);
+	const auto available = AvailableRect();
+	PushID(Label);
+
+	if (Cells.empty()) {
+		Count = 0;
+	}
+
+	// The cells are only solved again when anything they are solved from
+	// has changed, like the width of a resized window
+	auto &cache = context.LayoutStates.Touch(id, context.Frame);
+	if (cache.Tracks.size() != Count) {
+		cache.Tracks.resize(Count);
+		cache.Key = 0;
+	}
+
+	const HXGInt size = Axis == HXLayoutAxis::Horizontal ? available.CalWidth()
+	                                                     : std::max<HXGInt>(available.CalHeight(), 0);
+	const auto   key  = _HashInputs(Axis, Cells, Count, size, Gap, cache);
+	if (key != cache.Key) {
+		_Solve(Cells, Count, size, Gap, cache);
+
+		cache.Key = key;
+		++context.Profiler.Stats().LayoutsSolved;
+	} else {
+		++context.Profiler.Stats().LayoutsCached;
+	}
+
+	OpenLayout(available, Gap);
+
+	auto &frame = context.LayoutStack.back();
+	frame.Id    = id;
+	frame.Axis  = Axis;
+	frame.Count = Count;
+	for (const auto &track : cache.Tracks) {
+		context.LayoutTracks.push_back({.Offset = track.Offset, .Size = track.Size, .Mode = track.Mode});
+	}
+}
+}
+
+void BeginRow(HXLabel Label, std::span<const LayoutSize> Cells, HXGInt Gap) {
+	_BeginLayout(Label, HXLayoutAxis::Horizontal, Cells, Cells.size(), Gap);
+}
+
+void BeginRow(HXLabel Label, std::initializer_list<LayoutSize> Cells, HXGInt Gap) {
+	BeginRow(Label, std::span(Cells.begin(), Cells.size()), Gap);
+}
+
+void BeginColumn(HXLabel Label, std::span<const LayoutSize> Cells, HXGInt Gap) {
+	_BeginLayout(Label, HXLayoutAxis::Vertical, Cells, Cells.size(), Gap);
+}
+
+void BeginColumn(HXLabel Label, std::initializer_list<LayoutSize> Cells, HXGInt Gap) {
+	BeginColumn(Label, std::span(Cells.begin(), Cells.size()), Gap);
+}
+
+void BeginGrid(HXLabel Label, size_t Columns, LayoutSize Column, HXGInt Gap) {
+	_BeginLayout(Label, HXLayoutAxis::Horizontal, {&Column, 1}, Columns, Gap);
+}
+
+void EndLayout() {
+	auto &context = GetContext();
+
+	if (context.LayoutStack.empty() || context.LayoutStack.back().Id == HXNoID) {
+		context.Win       = false;
+		context.LastError = "EndLayout is called without BeginRow, BeginColumn or BeginGrid";
+
+		return;
+	}
+
+	// The content measured in the auto cells sizes them in the next frame,
+	// which changes the hash of the inputs only when the content changed
+	const auto &frame = context.LayoutStack.back();
+	auto       *cache = context.LayoutStates.Find(frame.Id);
+	for (size_t index = 0; index < frame.Count; ++index) {
+		cache->Tracks[index].Measured = context.LayoutTracks[frame.First + index].Measured;
+	}
+
+	const auto top    = frame.Bounds.Top;
+	const auto extent = CloseLayout();
+	PopID();
+
+	context.CurrentWindow->BaseLine = top;
+	PlaceControl(extent);
+}
+
+HXRect AvailableRect() {
+	auto &context = GetContext();
+	auto *window  = context.CurrentWindow;
+
+	if (context.LayoutStack.empty()) {
+		return {WindowMargin, window->BaseLine, window->Size.X - WindowMargin, window->PainterSize.Y - WindowMargin};
+	}
+
+	const auto &frame = context.LayoutStack.back();
+	if (frame.Axis == HXLayoutAxis::Vertical) {
+		if (frame.Cell < frame.Count) {
+			const auto &track = context.LayoutTracks[frame.First + frame.Cell];
+			if (track.Mode != SizeMode::Auto) {
+				return {frame.Bounds.Left, window->BaseLine, frame.Bounds.Right, window->BaseLine + track.Size};
+			}
+		}
+
+		return {frame.Bounds.Left, window->BaseLine, frame.Bounds.Right, frame.Bounds.Bottom};
+	}
+
+	if (frame.Count == 0) {
+		return {frame.Cursor, frame.LineTop, frame.Bounds.Right, frame.LineTop};
+	}
+
+	const auto  column = frame.Cell % frame.Count;
+	const auto  top    = column == 0 && frame.Cell != 0 ? frame.LineBottom + frame.Gap : frame.LineTop;
+	const auto &track  = context.LayoutTracks[frame.First + column];
+
+	return {frame.Bounds.Left + track.Offset, top, frame.Bounds.Left + track.Offset + track.Size, top};
+}
+
+HXRect PlaceControl(HXPoint Size) {
+	auto &context = GetContext();
+	auto *window  = context.CurrentWindow;
+
+	if (context.LayoutStack.empty()) {
+		const auto rect = HXRect{WindowMargin, window->BaseLine, WindowMargin + Size.X, window->BaseLine + Size.Y};
+		window->BaseLine = rect.Bottom + ControlGap;
+
+		return rect;
+	}
+
+	auto &frame = context.LayoutStack.back();
+	auto  rect  = HXRect{0, 0, 0, 0};
+	if (frame.Axis == HXLayoutAxis::Vertical) {
+		HXGInt height = Size.Y;
+		if (frame.Cell < frame.Count) {
+			auto &track = context.LayoutTracks[frame.First + frame.Cell];
+			switch (track.Mode) {
+			case SizeMode::Auto:
+				track.Measured = std::max(track.Measured, Size.Y);
+				break;
+			case SizeMode::Fixed:
+				height = track.Size;
+				break;
+			case SizeMode::Flex:
+				height = std::max(track.Size, Size.Y);
+				break;
+			}
+		}
+
+		rect             = {frame.Bounds.Left, window->BaseLine, frame.Bounds.Left + Size.X, window->BaseLine + height};
+		window->BaseLine = rect.Bottom + frame.Gap;
+	} else if (frame.Count == 0) {
+		rect         = {frame.Cursor, frame.LineTop, frame.Cursor + Size.X, frame.LineTop + Size.Y};
+		frame.Cursor = rect.Right + frame.Gap;
+	} else {
+		const auto column = frame.Cell % frame.Count;
+		if (column == 0 && frame.Cell != 0) {
+			frame.LineTop = frame.LineBottom + frame.Gap;
+		}
+
+		auto        &track = context.LayoutTracks[frame.First + column];
+		const HXGInt width = track.Mode == SizeMode::Auto ? Size.X : track.Size;
+
+		rect           = {frame.Bounds.Left + track.Offset, frame.LineTop, frame.Bounds.Left + track.Offset + width,
+		                  frame.LineTop + Size.Y};
+		track.Measured = std::max(track.Measured, Size.X);
+	}
+
+	++frame.Cell;
+	frame.LineBottom = std::max(frame.LineBottom, rect.Bottom);
+	frame.Right      = std::max(frame.Right, rect.Right);
+
+	return rect;
+}
+
+void OpenLayout(HXRect Bounds, HXGInt Gap) {
+	auto &context = GetContext();
+
+	context.LayoutStack.push_back({.Id         = HXNoID,
+	                               .Axis       = HXLayoutAxis::Vertical,
+	                               .Bounds     = Bounds,
+	                               .Gap        = Gap,
+	                               .First      = context.LayoutTracks.size(),
+	                               .Count      = 0,
+	                               .LineTop    = Bounds.Top,
+	                               .LineBottom = Bounds.Top,
+	                               .Cursor     = Bounds.Left,
+	                               .Right      = Bounds.Left});
+
+	context.CurrentWindow->BaseLine = Bounds.Top;
+}
+
+HXPoint CloseLayout() {
+	auto &context = GetContext();
+
+	if (context.LayoutStack.empty()) {
+		context.Win       = false;
+		context.LastError = "CloseLayout is called without OpenLayout";
+
+		return {0, 0};
+	}
+
+	const auto frame = context.LayoutStack.back();
+	context.LayoutStack.pop_back();
+	context.LayoutTracks.resize(frame.First);
+
+	// A vertical stack is measured by its base line, since the clipped
+	// lists move the base line past the items skipped without placing them
+	HXGInt bottom = frame.LineBottom;
+	if (frame.Axis == HXLayoutAxis::Vertical) {
+		bottom = std::max(bottom, context.CurrentWindow->BaseLine - (frame.Cell != 0 ? frame.Gap : 0));
+	}
+
+	return {frame.Right - frame.Bounds.Left, bottom - frame.Bounds.Top};
+}
+}
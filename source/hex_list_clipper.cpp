@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_list_clipper.cpp
+ * \brief The clipper of the long lists for HiEasyX
+ */
+
+#include <include/hex.h>
+#include <include/hex_list_clipper.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace HX {
+namespace {
+/**
+ * Getting the rows of the current window where the items are visible,
+ * relative to the window, a list in a scroll region is only visible in the
+ * viewport of the region
+ */
+std::pair<int64_t, int64_t> _VisibleRows(const HXWindow &Window) {
+	return {Window.ClipRect.Top, Window.ClipRect.Bottom};
+}
+
+HXGInt _ClampBaseLine(int64_t BaseLine) {
+	return static_cast<HXGInt>(std::clamp<int64_t>(BaseLine, std::numeric_limits<HXGInt>::min(),
+	                                               std::numeric_limits<HXGInt>::max()));
+}
+}
+
+ListHeights::ListHeights(HXGInt EstimatedHeight) : _offsets(1, 0), _estimated(EstimatedHeight) {
+}
+
+void ListHeights::Resize(size_t Count) {
+	_dirty = std::min(_dirty, std::min(Count, _heights.size()));
+	_heights.resize(Count, _estimated);
+	_offsets.resize(Count + 1);
+}
+
+size_t ListHeights::Size() const {
+	return _heights.size();
+}
+
+void ListHeights::Set(size_t Index, HXGInt Height) {
+	if (Index >= _heights.size() || _heights[Index] == Height) {
+		return;
+	}
+
+	_heights[Index] = Height;
+	_dirty          = std::min(_dirty, Index);
+}
+
+int64_t ListHeights::Offset(size_t Index) {
+	Update();
+
+	return _offsets[std::min(Index, _heights.size())];
+}
+
+size_t ListHeights::Find(int64_t Offset) {
+	if (_heights.empty()) {
+		return 0;
+	}
+
+	Update();
+
+	const auto next  = std::upper_bound(_offsets.begin(), _offsets.end(), Offset);
+	const auto index = static_cast<size_t>(std::max<ptrdiff_t>(next - _offsets.begin() - 1, 0));
+
+	return std::min(index, _heights.size() - 1);
+}
+
+void ListHeights::Update() {
+	// Only the offsets after the first item changed are summed again, so a
+	// list whose heights are all known costs nothing
+	for (size_t index = _dirty; index < _heights.size(); ++index) {
+		_offsets[index + 1] = _offsets[index] + _heights[index];
+	}
+	_dirty = _heights.size();
+}
+
+void ClipList(size_t Count, HXGInt ItemHeight, ListItem Item, void *User) {
+	auto &context = GetContext();
+	auto &window  = *context.CurrentWindow;
+	if (window.Folded || Count == 0) {
+		return;
+	}
+
+	const int64_t top   = window.BaseLine;
+	size_t        first = 0;
+
+	// The height of the items is taken from the first one when not given
+	if (ItemHeight <= 0) {
+		Item(0, User);
+
+		ItemHeight = std::max<HXGInt>(window.BaseLine - static_cast<HXGInt>(top), 1);
+		first      = 1;
+	}
+
+	const auto [visibleTop, visibleBottom] = _VisibleRows(window);
+	const auto count = static_cast<int64_t>(Count);
+	const auto begin = std::clamp<int64_t>((visibleTop - top) / ItemHeight, static_cast<int64_t>(first), count);
+	const auto end   = std::clamp<int64_t>((visibleBottom - top + ItemHeight - 1) / ItemHeight, begin, count);
+
+	// Every item starts on its own row, so an item taller than the others
+	// does not move the items after it
+	for (auto index = begin; index < end; ++index) {
+		window.BaseLine = _ClampBaseLine(top + index * ItemHeight);
+		Item(static_cast<size_t>(index), User);
+	}
+
+	window.BaseLine = _ClampBaseLine(top + count * ItemHeight);
+}
+
+void ClipList(ListHeights &Heights, ListItem Item, void *User) {
+	auto &context = GetContext();
+	auto &window  = *context.CurrentWindow;
+	if (window.Folded || Heights.Size() == 0) {
+		return;
+	}
+
+	const int64_t top = window.BaseLine;
+
+	// The items are laid out from the first visible one until the window is
+	// filled, the heights learned on the way move the items after them, and
+	// the offsets are only summed again once the list is done
+	const auto [visibleTop, visibleBottom] = _VisibleRows(window);
+
+	auto    index   = Heights.Find(visibleTop - top);
+	int64_t itemTop = top + Heights.Offset(index);
+	for (; index < Heights.Size() && itemTop < visibleBottom; ++index) {
+		window.BaseLine = _ClampBaseLine(itemTop);
+		Item(index, User);
+
+		const HXGInt height = window.BaseLine - _ClampBaseLine(itemTop);
+		Heights.Set(index, height);
+		itemTop += height;
+	}
+
+	window.BaseLine = _ClampBaseLine(top + Heights.Offset(Heights.Size()));
+}
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * \file hex_measure_cache.cpp
+ * \brief The cache of text measurements
+ */
+
+#include <include/hex_measure_cache.h>
+
+#include <bit>
+
+HXMeasureCache::HXMeasureCache(size_t Capacity) {
+	Capacity = std::bit_ceil(std::max<size_t>(Capacity, 1));
+
+	_entries.resize(Capacity);
+	_mask = Capacity - 1;
+}
+
+HXRect HXMeasureCache::Measure(HXBufferPainter *Painter, HXStringView Text, HXFontHandle Font, HXGUInt Height) {
+	const auto key   = HXHashCombine(HXHashCombine(HXHashString(Text.data(), Text.size()), Font.Key()), Height);
+	auto      &entry = _entries[static_cast<size_t>(key) & _mask];
+	if (entry.Used && entry.Key == key && entry.Length == Text.size()) {
+		++_stats.Hits;
+
+		return entry.Result;
+	}
+
+	++_stats.Misses;
+	if (entry.Used) {
+		++_stats.Evictions;
+	}
+
+	entry = Entry{.Key = key, .Length = Text.size(), .Result = Painter->MeasureText(Text, Font, Height), .Used = true};
+
+	return entry.Result;
+}
+
+void HXMeasureCache::Clear() {
+	std::fill(_entries.begin(), _entries.end(), Entry{});
+}
+
+const HXMeasureCacheStats &HXMeasureCache::Stats() const {
+	return _stats;
+}
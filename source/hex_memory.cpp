@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_memory.cpp
+ * \brief The counted allocation hooks of HiEasyX
+ */
+
+#include <include/hex_memory.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <utility>
+
+namespace {
+constexpr size_t TagCount = static_cast<size_t>(HXMemoryTag::Count);
+
+struct AtomicCounter {
+	std::atomic<uint64_t> Allocations = 0;
+	std::atomic<uint64_t> Frees       = 0;
+	std::atomic<uint64_t> Bytes       = 0;
+	std::atomic<uint64_t> FreedBytes  = 0;
+};
+
+AtomicCounter Counters[TagCount];
+HXMemoryHooks Hooks;
+
+// The guard only flags the thread arming it, so the frame of one context
+// never flags the allocations of the others. The pool threads arm it
+// themselves while they run the tasks of a guarded frame
+thread_local HXAllocationGuard Guard   = HXAllocationGuard::Off;
+thread_local uint64_t          Guarded = 0;
+
+void *_DefaultAllocate(size_t Size, size_t Alignment, HXMemoryTag, void *) {
+	return ::operator new(Size, std::align_val_t(Alignment));
+}
+
+void _DefaultFree(void *Memory, size_t Size, size_t Alignment, HXMemoryTag, void *) {
+	::operator delete(Memory, Size, std::align_val_t(Alignment));
+}
+}
+
+const char *HXMemoryTagName(HXMemoryTag Tag) {
+	constexpr const char *names[TagCount] = {"General", "Window", "Painter", "DrawList",
+	                                         "Input",   "Layout", "Arena",   "Text"};
+
+	return static_cast<size_t>(Tag) < TagCount ? names[static_cast<size_t>(Tag)] : "Unknown";
+}
+
+void HXSetMemoryHooks(const HXMemoryHooks &NewHooks) {
+	if (NewHooks.Allocate != nullptr && NewHooks.Free != nullptr) {
+		Hooks = NewHooks;
+	} else {
+		Hooks = HXMemoryHooks{};
+	}
+}
+
+HXMemoryCounter HXMemoryStats::Total() const {
+	HXMemoryCounter total;
+	for (auto &counter : Tags) {
+		total.Allocations += counter.Allocations;
+		total.Frees += counter.Frees;
+		total.Bytes += counter.Bytes;
+		total.FreedBytes += counter.FreedBytes;
+	}
+
+	return total;
+}
+
+HXMemoryStats HXMemoryStats::Delta(const HXMemoryStats &Since) const {
+	HXMemoryStats delta;
+	for (size_t tag = 0; tag < TagCount; ++tag) {
+		delta.Tags[tag] = {.Allocations = Tags[tag].Allocations - Since.Tags[tag].Allocations,
+		                   .Frees       = Tags[tag].Frees - Since.Tags[tag].Frees,
+		                   .Bytes       = Tags[tag].Bytes - Since.Tags[tag].Bytes,
+		                   .FreedBytes  = Tags[tag].FreedBytes - Since.Tags[tag].FreedBytes};
+	}
+
+	return delta;
+}
+
+HXMemoryStats HXGetMemoryStats() {
+	HXMemoryStats stats;
+	for (size_t tag = 0; tag < TagCount; ++tag) {
+		stats.Tags[tag] = {.Allocations = Counters[tag].Allocations.load(std::memory_order_relaxed),
+		                   .Frees       = Counters[tag].Frees.load(std::memory_order_relaxed),
+		                   .Bytes       = Counters[tag].Bytes.load(std::memory_order_relaxed),
+		                   .FreedBytes  = Counters[tag].FreedBytes.load(std::memory_order_relaxed)};
+	}
+
+	return stats;
+}
+
+HXAllocationGuard HXArmAllocationGuard(HXAllocationGuard Mode) {
+	return std::exchange(Guard, Mode);
+}
+
+uint64_t HXGuardedAllocations() {
+	return Guarded;
+}
+
+void *HXAllocate(size_t Size, size_t Alignment, HXMemoryTag Tag) {
+	auto &counter = Counters[static_cast<size_t>(Tag)];
+	counter.Allocations.fetch_add(1, std::memory_order_relaxed);
+	counter.Bytes.fetch_add(Size, std::memory_order_relaxed);
+
+	if (Guard != HXAllocationGuard::Off) {
+		++Guarded;
+		if (Guard == HXAllocationGuard::Abort) {
+			std::abort();
+		}
+	}
+
+	if (Hooks.Allocate == nullptr) {
+		return _DefaultAllocate(Size, Alignment, Tag, nullptr);
+	}
+
+	auto memory = Hooks.Allocate(Size, Alignment, Tag, Hooks.User);
+	if (memory == nullptr) {
+		throw std::bad_alloc();
+	}
+
+	return memory;
+}
+
+void HXFree(void *Memory, size_t Size, size_t Alignment, HXMemoryTag Tag) {
+	if (Memory == nullptr) {
+		return;
+	}
+
+	auto &counter = Counters[static_cast<size_t>(Tag)];
+	counter.Frees.fetch_add(1, std::memory_order_relaxed);
+	counter.FreedBytes.fetch_add(Size, std::memory_order_relaxed);
+
+	if (Hooks.Free == nullptr) {
+		_DefaultFree(Memory, Size, Alignment, Tag, nullptr);
+	} else {
+		Hooks.Free(Memory, Size, Alignment, Tag, Hooks.User);
+	}
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_message_queue.cpp
+ * \brief The queue of the messages pushed in a frame
+ */
+
+#include <include/hex_message_queue.h>
+
+#include <algorithm>
+#include <bit>
+
+HXMessageQueue::HXMessageQueue(size_t Capacity) {
+	Capacity = std::bit_ceil(std::max<size_t>(Capacity, 1));
+
+	_ring.resize(Capacity);
+	_mask = Capacity - 1;
+}
+
+bool HXMessageQueue::IsMove(const HXMessage &Message) {
+	return Message.MouseAction && !Message.MouseLeftPressed && !Message.MouseLeftRelease && Message.MouseWheel == 0;
+}
+
+bool HXMessageQueue::IsTransition(const HXMessage &Message) {
+	return Message.MouseLeftPressed || Message.MouseLeftRelease;
+}
+
+bool HXMessageQueue::EvictMove() {
+	for (size_t index = _sealed; index < _size; ++index) {
+		if (!IsMove((*this)[index]) || (*this)[index].Processed) {
+			continue;
+		}
+
+		// The messages after the move carry their own positions, so the
+		// position of the move is not needed anymore
+		for (; index + 1 < _size; ++index) {
+			(*this)[index] = (*this)[index + 1];
+		}
+		--_size;
+
+		return true;
+	}
+
+	return false;
+}
+
+void HXMessageQueue::Grow() {
+	HXVector<HXMessage, HXMemoryTag::Input> ring(_ring.size() * 2);
+	for (size_t index = 0; index < _size; ++index) {
+		ring[index] = (*this)[index];
+	}
+
+	_ring.swap(ring);
+	_mask = _ring.size() - 1;
+	_head = 0;
+}
+
+void HXMessageQueue::Push(const HXMessage &Message) {
+	++_stats.Pushed;
+
+	// A move only updates the position of the move before it, the button
+	// transitions are never merged so no click can be lost
+	if (_size > _sealed && IsMove(Message)) {
+		auto &last = (*this)[_size - 1];
+		if (IsMove(last) && !last.Processed) {
+			last.MouseX = Message.MouseX;
+			last.MouseY = Message.MouseY;
+			++_stats.Merged;
+
+			return;
+		}
+	}
+
+	// A wheel rolling on adds its distance to the wheel before it
+	if (_size > _sealed && Message.MouseWheel != 0) {
+		auto &last = (*this)[_size - 1];
+		if (last.MouseWheel != 0 && !last.Processed) {
+			last.MouseX = Message.MouseX;
+			last.MouseY = Message.MouseY;
+			last.MouseWheel += Message.MouseWheel;
+			++_stats.Merged;
+
+			return;
+		}
+	}
+
+	if (_size == _ring.size()) {
+		if (!IsTransition(Message)) {
+			++_stats.Dropped;
+
+			return;
+		}
+
+		if (EvictMove()) {
+			++_stats.Dropped;
+		} else {
+			Grow();
+		}
+	}
+
+	(*this)[_size++] = Message;
+}
+
+void HXMessageQueue::Seal() {
+	_sealed = _size;
+}
+
+void HXMessageQueue::Clear() {
+	_head   = (_head + _size) & _mask;
+	_size   = 0;
+	_sealed = 0;
+}
+
+size_t HXMessageQueue::Size() const {
+	return _size;
+}
+
+HXMessage &HXMessageQueue::operator[](size_t Index) {
+	return _ring[(_head + Index) & _mask];
+}
+
+const HXMessage &HXMessageQueue::operator[](size_t Index) const {
+	return _ring[(_head + Index) & _mask];
+}
+
+const HXMessageQueueStats &HXMessageQueue::Stats() const {
+	return _stats;
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_profiler.cpp
+ * \brief The frame profiler of HiEasyX
+ */
+
+#include <include/hex_profiler.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+namespace {
+uint64_t _SteadyNanoseconds() {
+	return static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+		.count());
+}
+
+/**
+ * Writing a label as a JSON string, the characters which need escaping are
+ * replaced since the labels are only for reading
+ */
+void _WriteLabel(std::ostream &Stream, const char *Label) {
+	Stream << '"';
+	for (; *Label != '\0'; ++Label) {
+		const char character = *Label;
+		Stream << (character == '"' || character == '\\' || static_cast<unsigned char>(character) < 0x20 ? '_'
+			           : character);
+	}
+	Stream << '"';
+}
+
+/**
+ * Writing nanoseconds as the microseconds Chrome traces use
+ */
+void _WriteMicroseconds(std::ostream &Stream, uint64_t Nanoseconds) {
+	Stream << Nanoseconds / 1000 << '.' << Nanoseconds / 100 % 10 << Nanoseconds / 10 % 10 << Nanoseconds % 10;
+}
+}
+
+HXProfiler::HXProfiler(size_t Capacity, size_t FrameCapacity) : _epoch(_SteadyNanoseconds()) {
+	_events.resize(std::bit_ceil(std::max<size_t>(Capacity, 1)));
+	_mask = _events.size() - 1;
+
+	_frames.resize(std::max<size_t>(FrameCapacity, 1));
+}
+
+void HXProfiler::SetEnabled(bool Enable) {
+	_enabled.store(Enable, std::memory_order_relaxed);
+}
+
+bool HXProfiler::Enabled() const {
+	return _enabled.load(std::memory_order_relaxed);
+}
+
+uint64_t HXProfiler::Now() const {
+	return _SteadyNanoseconds() - _epoch;
+}
+
+uint32_t HXProfiler::ThreadIndex() {
+	static std::atomic<uint32_t> threads = 0;
+	thread_local const uint32_t  index   = threads.fetch_add(1, std::memory_order_relaxed);
+
+	return index;
+}
+
+void HXProfiler::Record(const char *Name, HXStringView Label, uint64_t Frame, uint64_t Begin, uint64_t End) {
+	auto &event = _events[_next.fetch_add(1, std::memory_order_relaxed) & _mask];
+
+	event.Name   = Name;
+	event.Frame  = Frame;
+	event.Begin  = Begin;
+	event.End    = End;
+	event.Thread = ThreadIndex();
+
+	// The labels are narrowed so a wide title still reads in the trace
+	const size_t length = std::min(Label.size(), sizeof(event.Label) - 1);
+	for (size_t index = 0; index < length; ++index) {
+		const auto character = static_cast<uint32_t>(Label[index]);
+		event.Label[index]   = character < 0x80 ? static_cast<char>(character) : '?';
+	}
+	event.Label[length] = '\0';
+}
+
+void HXProfiler::Open(const char *Name, HXStringView Label, uint64_t Frame) {
+	Close();
+	if (!Enabled()) {
+		return;
+	}
+
+	_openName  = Name;
+	_openLabel = Label;
+	_openFrame = Frame;
+	_openBegin = Now();
+}
+
+void HXProfiler::Close() {
+	if (_openName == nullptr) {
+		return;
+	}
+
+	Record(_openName, _openLabel, _openFrame, _openBegin, Now());
+	_openName = nullptr;
+}
+
+void HXProfiler::BeginFrame(uint64_t Frame) {
+	if (_current.Frame != 0) {
+		_frames[_frameCount % _frames.size()] = _current;
+		++_frameCount;
+	}
+
+	_current = HXFrameStats{.Frame = Frame, .Start = Now()};
+}
+
+HXFrameStats &HXProfiler::Stats() {
+	return _current;
+}
+
+void HXProfiler::ExportChromeTrace(std::ostream &Stream) const {
+	Stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	bool first = true;
+	auto separate = [&Stream, &first] {
+		if (!first) {
+			Stream << ",\n";
+		}
+		first = false;
+	};
+
+	const uint64_t next   = _next.load(std::memory_order_acquire);
+	const uint64_t events = std::min<uint64_t>(next, _events.size());
+	for (uint64_t index = next - events; index < next; ++index) {
+		const auto &event = _events[index & _mask];
+
+		separate();
+		Stream << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << event.Thread << ",\"name\":\"" << event.Name << "\",\"ts\":";
+		_WriteMicroseconds(Stream, event.Begin);
+		Stream << ",\"dur\":";
+		_WriteMicroseconds(Stream, event.End - event.Begin);
+		Stream << ",\"args\":{\"frame\":" << event.Frame << ",\"label\":";
+		_WriteLabel(Stream, event.Label);
+		Stream << "}}";
+	}
+
+	// The counters are written as counter tracks, one sample per frame
+	const uint64_t frames = std::min<uint64_t>(_frameCount, _frames.size());
+	for (uint64_t index = _frameCount - frames; index < _frameCount; ++index) {
+		const auto &stats = _frames[index % _frames.size()];
+
+		separate();
+		Stream << "{\"ph\":\"C\",\"pid\":1,\"name\":\"Frame\",\"ts\":";
+		_WriteMicroseconds(Stream, stats.Start);
+		Stream << ",\"args\":{\"messages\":" << stats.Messages << ",\"windows\":" << stats.Windows
+		       << ",\"windowsReplayed\":" << stats.WindowsReplayed << ",\"drawCommands\":" << stats.DrawCommands
+		       << ",\"textMeasures\":" << stats.TextMeasures << ",\"compositeTiles\":" << stats.CompositeTiles
+		       << ",\"layoutsSolved\":" << stats.LayoutsSolved << ",\"layoutsCached\":" << stats.LayoutsCached
+		       << "}}";
+
+		separate();
+		Stream << "{\"ph\":\"C\",\"pid\":1,\"name\":\"Frame Memory\",\"ts\":";
+		_WriteMicroseconds(Stream, stats.Start);
+		Stream << ",\"args\":{\"allocations\":" << stats.Allocations << ",\"bytes\":" << stats.AllocatedBytes
+		       << "}}";
+
+		separate();
+		Stream << "{\"ph\":\"C\",\"pid\":1,\"name\":\"Frame Time (ms)\",\"ts\":";
+		_WriteMicroseconds(Stream, stats.Start);
+		Stream << ",\"args\":{\"layout\":" << static_cast<double>(stats.LayoutTime) / 1e6
+		       << ",\"render\":" << static_cast<double>(stats.RenderTime) / 1e6 << "}}";
+	}
+
+	Stream << "]}\n";
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_scroll.cpp
+ * \brief The scroll regions for HiEasyX
+ */
+
+#include <include/hex.h>
+#include <include/hex_scroll.h>
+
+#include <algorithm>
+
+namespace HX {
+namespace {
+constexpr HXGInt ControlGap = 5;
+constexpr HXGInt Padding    = 5;
+constexpr HXGInt BarWidth   = 8;
+constexpr HXGInt MinThumb   = 20;
+
+// The distance scrolled by a notch of the wheel, which is 120
+constexpr HXGInt WheelStep = 48;
+
+bool _Contains(const HXRect &Rect, HXPoint Point) {
+	return Point.X >= Rect.Left && Point.X < Rect.Right && Point.Y >= Rect.Top && Point.Y < Rect.Bottom;
+}
+
+void _BeginScroll(HXStringView Title, ScrollProfile &Profile, HXID StateId) {
+	auto &context = GetContext();
+	auto *window  = context.CurrentWindow;
+
+	PushID(Title);
+
+	// A region of a folded window is still opened, so HX::EndScroll finds
+	// its region as usual
+	if (window->Folded) {
+		context.ScrollStack.push_back({.Profile = nullptr, .StateId = HXNoID});
+
+		return;
+	}
+
+	const auto   available = AvailableRect();
+	const HXGInt width     = Profile.Size.X > 0 ? Profile.Size.X : available.CalWidth();
+	const auto   viewport  = HXRect{available.Left, available.Top, available.Left + width,
+	                                available.Top + Profile.Size.Y};
+
+	// The offset is clamped by the content measured in the last frame, the
+	// scroll bar takes its place only when there is something to scroll
+	const HXGInt maxOffset = std::max<HXGInt>(Profile.ContentHeight - viewport.CalHeight(), 0);
+	Profile.Offset         = std::clamp<HXGInt>(Profile.Offset, 0, maxOffset);
+
+	const auto content = HXRect{viewport.Left, viewport.Top, viewport.Right - (maxOffset > 0 ? BarWidth : 0),
+	                            viewport.Bottom};
+
+	context.ScrollStack.push_back(
+		{.Profile = &Profile, .StateId = StateId, .Viewport = viewport, .ParentClip = window->ClipRect});
+
+	window->ClipRect = content.Intersect(window->ClipRect);
+	window->DrawList.AddClipRect(window->ClipRect);
+
+	// The widgets of the region are stacked in the content moved up by the
+	// offset, the height of the stack is not limited
+	const HXGInt contentTop = viewport.Top + Padding - Profile.Offset;
+	OpenLayout({content.Left + Padding, contentTop, content.Right - Padding, contentTop}, ControlGap);
+}
+}
+
+void BeginScroll(HXStringView Title, ScrollProfile &Profile) {
+	_BeginScroll(Title, Profile, HXNoID);
+}
+
+void BeginScroll(HXStringView Title, HXPoint Size) {
+	auto &context = GetContext();
+
+	const auto id      = GetID(Title);
+	auto      &profile = context.ScrollStates.Touch(id, context.Frame);
+	profile.Size       = Size;
+
+	_BeginScroll(Title, profile, id);
+}
+
+void EndScroll() {
+	auto &context = GetContext();
+	auto &theme   = GetTheme();
+	auto *window  = context.CurrentWindow;
+
+	if (context.ScrollStack.empty()) {
+		context.Win       = false;
+		context.LastError = "EndScroll is called without BeginScroll";
+
+		return;
+	}
+
+	const auto region = context.ScrollStack.back();
+	context.ScrollStack.pop_back();
+	PopID();
+
+	if (region.Profile == nullptr) {
+		return;
+	}
+
+	auto &Profile = region.StateId != HXNoID ? *context.ScrollStates.Find(region.StateId) : *region.Profile;
+
+	Profile.ContentHeight = CloseLayout().Y + Padding * 2;
+
+	window->ClipRect = region.ParentClip;
+	window->DrawList.AddClipRect(region.ParentClip);
+
+	const auto   viewport       = region.Viewport;
+	const HXGInt viewportHeight = viewport.CalHeight();
+	const HXGInt maxOffset      = std::max<HXGInt>(Profile.ContentHeight - viewportHeight, 0);
+	const HXGInt thumbHeight    = maxOffset > 0 ? std::clamp<HXGInt>(viewportHeight * viewportHeight /
+	                                                                 Profile.ContentHeight,
+	                                                                 MinThumb, viewportHeight)
+	                                            : viewportHeight;
+	const auto track = HXRect{viewport.Right - BarWidth, viewport.Top, viewport.Right, viewport.Bottom};
+
+	// The content can be far taller than the viewport, so the scaling is
+	// done in 64 bits
+	auto thumbTop = [&] {
+		return track.Top + (maxOffset > 0 ? static_cast<HXGInt>(static_cast<int64_t>(viewportHeight - thumbHeight) *
+		                                                       Profile.Offset / maxOffset)
+		                                  : 0);
+	};
+
+	// The wheel and the scroll bar are handled after the widgets of the
+	// region, so the messages taken by the widgets are already processed.
+	// The messages are taken from the window in their order, a dragged
+	// thumb keeps receiving them after the mouse has left the bar
+	const auto visible = viewport.Intersect(region.ParentClip);
+	for (auto messageIndex : window->Inbox) {
+		auto &Message = context.MessageQuery[messageIndex];
+		if (Message.Processed) {
+			continue;
+		}
+
+		const auto mouse = ClipCoord({Message.MouseX, Message.MouseY});
+		if (Profile.InDrag) {
+			if (Message.MouseLeftRelease) {
+				Profile.InDrag = false;
+			}
+
+			const HXGInt  travel = std::max<HXGInt>(viewportHeight - thumbHeight, 1);
+			const int64_t moved  = static_cast<int64_t>(mouse.Y - Profile.DragOrigin) * maxOffset / travel;
+
+			Profile.Offset    = static_cast<HXGInt>(std::clamp<int64_t>(Profile.DragOffset + moved, 0, maxOffset));
+			Message.Processed = true;
+
+			continue;
+		}
+
+		if (!_Contains(visible, mouse)) {
+			continue;
+		}
+
+		if (Message.MouseWheel != 0) {
+			Profile.Offset -= Message.MouseWheel * WheelStep / 120;
+			Message.Processed = true;
+		} else if (Message.MouseLeftPressed && maxOffset > 0 && _Contains(track, mouse)) {
+			const HXGInt top = thumbTop();
+			if (mouse.Y >= top && mouse.Y < top + thumbHeight) {
+				Profile.InDrag     = true;
+				Profile.DragOrigin = mouse.Y;
+				Profile.DragOffset = Profile.Offset;
+			} else {
+				Profile.Offset += mouse.Y < top ? -viewportHeight : viewportHeight;
+			}
+
+			Message.Processed = true;
+		}
+	}
+	Profile.Offset = std::clamp<HXGInt>(Profile.Offset, 0, maxOffset);
+
+	// A dragged thumb captures the mouse for the next frame, like a dragged
+	// window does
+	window->Captured = window->Captured || Profile.InDrag;
+
+	auto &drawList = window->DrawList;
+	if (IsVisible({viewport.Left, viewport.Top, viewport.Right - 1, viewport.Bottom - 1})) {
+		if (maxOffset > 0) {
+			const HXGInt top   = thumbTop();
+			const auto   thumb = Profile.InDrag ? theme.ButtonPressedBackground : theme.ButtonBorder;
+
+			drawList.AddFilledRectangle({track.Left, track.Top, track.Right - 1, track.Bottom - 1},
+			                            theme.ButtonBackground, theme.ButtonBackground);
+			drawList.AddFilledRectangle({track.Left, top, track.Right - 1, top + thumbHeight - 1}, thumb, thumb);
+		}
+		drawList.AddRectangle({viewport.Left, viewport.Top, viewport.Right - 1, viewport.Bottom - 1},
+		                      theme.ButtonBorder);
+	}
+
+	window->BaseLine = viewport.Top;
+	PlaceControl({viewport.CalWidth(), viewport.CalHeight()});
+}
+}
@@ -35,43 +35,39 @@ TextProfile::TextProfile() {
 	Color = theme.WindowTitleText;
 }
 
-void Text(const HXString &Title) {
+void Text(HXStringView Title) {
 	auto& theme = GetTheme();
 	auto& context = GetContext();
-	constexpr HXGInt ControlGap = 5;
 
 	if (context.CurrentWindow->Folded) {
 		return;
 	}
 
-	constexpr HXGInt leftGap = 10;
-
-	context.CurrentWindow->Painter->Begin();
-	context.CurrentWindow->Painter->DrawText(Title, HXFont{}, {leftGap, context.CurrentWindow->BaseLine},
-											 theme.WindowTitleText, 18);
-	context.CurrentWindow->Painter->End();
-
-	context.CurrentWindow->BaseLine += context.CurrentWindow->Painter->MeasureText(Title, HXFont{}, 18).Bottom +
-		ControlGap;
+	// A text scrolled out of sight is only measured to be laid out
+	const auto textRect = MeasureText(Title, HXFontHandle{}, 18);
+	const auto where    = PlaceControl({textRect.Right, textRect.Bottom});
+	if (IsVisible(where)) {
+		context.CurrentWindow->DrawList.AddText(Title, HXFontHandle{}, {where.Left, where.Top}, theme.WindowTitleText,
+		                                        18);
+	}
 }
 
-void Text(const HXString &Title, TextProfile &Profile) {
+void Text(HXStringView Title, TextProfile &Profile) {
 	auto& context = GetContext();
 
-	constexpr HXGInt ControlGap = 5;
-
 	if (context.CurrentWindow->Folded) {
 		return;
 	}
 
-	constexpr HXGInt leftGap = 10;
-
-	context.CurrentWindow->Painter->Begin();
-	context.CurrentWindow->Painter->DrawText(Title, Profile.Font, {leftGap, context.CurrentWindow->BaseLine},
-											 Profile.Color, Profile.Height);
-	context.CurrentWindow->Painter->End();
+	if (Profile.InternedFont.Font() != Profile.Font) {
+		Profile.InternedFont = HXFontHandle(Profile.Font);
+	}
 
-	context.CurrentWindow->BaseLine += context.CurrentWindow->Painter->MeasureText(Title, HXFont{}, Profile.Height).
-		Bottom + ControlGap;
+	const auto textRect = MeasureText(Title, Profile.InternedFont, Profile.Height);
+	const auto where    = PlaceControl({textRect.Right, textRect.Bottom});
+	if (IsVisible(where)) {
+		context.CurrentWindow->DrawList.AddText(Title, Profile.InternedFont, {where.Left, where.Top}, Profile.Color,
+		                                        Profile.Height);
+	}
 }
 }
\ No newline at end of file
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_thread_pool.cpp
+ * \brief The work-stealing thread pool
+ */
+
+#include <include/hex_thread_pool.h>
+
+namespace {
+// The pool the current thread works for and its queue, a thread outside
+// any pool has no queue of its own
+thread_local const HXThreadPool *_WorkerPool  = nullptr;
+thread_local size_t              _WorkerIndex = 0;
+}
+
+HXThreadPool::HXThreadPool(size_t Workers) {
+	Workers = std::max<size_t>(Workers, 1);
+
+	for (size_t index = 0; index < Workers; ++index) {
+		_queues.push_back(std::make_unique<Queue>());
+	}
+	for (size_t index = 0; index < Workers; ++index) {
+		_threads.emplace_back(&HXThreadPool::WorkerLoop, this, index);
+	}
+}
+
+HXThreadPool::~HXThreadPool() {
+	{
+		std::lock_guard lock(_sleepLock);
+		_stop = true;
+	}
+	_wake.notify_all();
+
+	for (auto &thread : _threads) {
+		thread.join();
+	}
+}
+
+void HXThreadPool::Submit(HXTaskGroup &Group, void (*Function)(void *), void *Argument) {
+	Group.Pending.fetch_add(1, std::memory_order_relaxed);
+
+	const size_t home = _WorkerPool == this ? _WorkerIndex : _next.fetch_add(1, std::memory_order_relaxed) %
+	                                                         _queues.size();
+	{
+		std::lock_guard lock(_queues[home]->Lock);
+		_queues[home]->Tasks.push_back({.Function = Function, .Argument = Argument, .Group = &Group});
+	}
+	_queued.fetch_add(1, std::memory_order_release);
+
+	// Taking the sleep lock orders the notification after the check of a
+	// worker going to sleep, so no wake up can be lost
+	{
+		std::lock_guard lock(_sleepLock);
+	}
+	_wake.notify_one();
+}
+
+void HXThreadPool::Wait(HXTaskGroup &Group) {
+	const size_t home = _WorkerPool == this ? _WorkerIndex : 0;
+	while (Group.Pending.load(std::memory_order_acquire) != 0) {
+		Task task;
+		if (TryTake(home, task)) {
+			Run(task);
+
+			continue;
+		}
+
+		// The tasks left are running on the other threads, the waiter
+		// sleeps until they finish or more tasks are queued
+		std::unique_lock lock(_sleepLock);
+		_wake.wait(lock, [this, &Group] {
+			return Group.Pending.load(std::memory_order_acquire) == 0 ||
+			       _queued.load(std::memory_order_acquire) != 0;
+		});
+	}
+}
+
+size_t HXThreadPool::Workers() const {
+	return _threads.size();
+}
+
+void HXThreadPool::WorkerLoop(size_t Index) {
+	_WorkerPool  = this;
+	_WorkerIndex = Index;
+
+	while (true) {
+		Task task;
+		if (TryTake(Index, task)) {
+			Run(task);
+
+			continue;
+		}
+
+		std::unique_lock lock(_sleepLock);
+		_wake.wait(lock, [this] {
+			return _stop || _queued.load(std::memory_order_acquire) != 0;
+		});
+		if (_stop) {
+			return;
+		}
+	}
+}
+
+bool HXThreadPool::TryTake(size_t Home, Task &Result) {
+	if (_queued.load(std::memory_order_acquire) == 0) {
+		return false;
+	}
+
+	// The own queue is used as a stack for locality, the others are robbed
+	// from the other end
+	for (size_t offset = 0; offset < _queues.size(); ++offset) {
+		auto           &queue = *_queues[(Home + offset) % _queues.size()];
+		std::lock_guard lock(queue.Lock);
+		if (queue.Head == queue.Tasks.size()) {
+			continue;
+		}
+
+		if (offset == 0) {
+			Result = queue.Tasks.back();
+			queue.Tasks.pop_back();
+		} else {
+			Result = queue.Tasks[queue.Head++];
+		}
+		if (queue.Head == queue.Tasks.size()) {
+			queue.Tasks.clear();
+			queue.Head = 0;
+		}
+		_queued.fetch_sub(1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	return false;
+}
+
+void HXThreadPool::Run(const Task &Work) {
+	Work.Function(Work.Argument);
+
+	// The group may be gone once its last task is done, so only the pool
+	// is touched to wake the waiters
+	if (Work.Group->Pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		{
+			std::lock_guard lock(_sleepLock);
+		}
+		_wake.notify_all();
+	}
+}
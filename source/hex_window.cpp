@@ -28,24 +28,93 @@
 #include <include/hex.h>
 #include <include/hex_window.h>
 
+#include <cmath>
+
 namespace HX {
-void Window(const HXString &Title, WindowProfile &Profile) {
+namespace {
+/**
+ * Getting the identity of a window in this frame, the windows sharing a
+ * title are told apart by the order they are submitted in, so each of them
+ * keeps its own pooled window across frames
+ */
+HXID _WindowID(HXRuntimeContext &Context, HXLabel Title) {
+	const auto title = HXMakeID(HXHashSeed, Title);
+
+	auto id = title;
+	for (uint64_t occurrence = 1;; ++occurrence) {
+		const auto window = Context.WindowPool.find(id);
+		if (window == Context.WindowPool.end() || window->second->LastFrame != Context.Frame) {
+			return id;
+		}
+
+		id = HXHashCombine(title, occurrence);
+		id = id != HXNoID ? id : 1;
+	}
+}
+
+void _Window(HXID Id, HXStringView Title, WindowProfile &Profile) {
 	auto &context = GetContext();
 	auto &theme   = GetTheme();
-	auto  window  = new HXWindow{.Title = Title, .Size = Profile.Size, .Where = HXPoint{0, 0},
-	                           .Folded = Profile.Folded};
-	context.Windows.emplace_back(window);
-	context.CurrentWindow = context.Windows.back();
 
-	context.CurrentWindow->Where = Profile.Position;
+	// The layout of the last window ends here, the routing is its own span
+	context.Profiler.Close();
 
-	if (Profile.Folded) {
-		context.CurrentWindow->Painter = context.RenderContext->DefaultPainter()->CreateSubPainter(
-			context.CurrentWindow->Size.X, 40);
-	} else {
+	// The messages are routed with the layout of the last frame, so it must
+	// happen before any window changes its layout
+	RouteMessages();
+
+	// The window is reused from the pool if it is alive, only the per frame
+	// state is refreshed, so the title is only copied for a new window
+	auto &window = context.WindowPool[Id];
+	if (window == nullptr) {
+		window = new HXWindow{.Id = Id, .Title = HXString(Title), .Context = &context};
+	}
+	window->Size      = Profile.Size;
+	window->Where     = Profile.Position;
+	window->Folded    = Profile.Folded;
+	window->Opacity   = Profile.Opacity;
+	window->BaseLine  = 50;
+	window->LastFrame = context.Frame;
+	window->DrawList.Reset();
+	window->ControlRects.clear();
+	window->ControlCursor = 0;
+
+	// The layout of the window lasts until the next window or HX::End
+	context.Profiler.Open("Layout", window->Title, context.Frame);
+	++context.Profiler.Stats().Windows;
+
+	// The scroll regions and the layouts never span windows
+	if (!context.LayoutStack.empty()) {
+		context.Win       = false;
+		context.LastError = "EndLayout is needed for every layout";
+
+		context.LayoutStack.clear();
+		context.LayoutTracks.clear();
+	}
+	if (!context.ScrollStack.empty()) {
+		context.Win       = false;
+		context.LastError = "EndScroll is needed for every BeginScroll";
+
+		context.ScrollStack.clear();
+	}
+
+	context.Windows.emplace_back(window);
+	context.CurrentWindow = window;
+	context.IDStack.assign(1, Id);
+
+	const HXGInt painterHeight = Profile.Folded ? 40 : context.CurrentWindow->Size.Y;
+	if (context.CurrentWindow->Painter == nullptr) {
 		context.CurrentWindow->Painter = context.RenderContext->DefaultPainter()->CreateSubPainter(
-			context.CurrentWindow->Size.X, context.CurrentWindow->Size.Y);
+			context.CurrentWindow->Size.X, painterHeight);
+	} else if (context.CurrentWindow->PainterSize.X != context.CurrentWindow->Size.X ||
+	           context.CurrentWindow->PainterSize.Y != painterHeight) {
+		context.CurrentWindow->Painter->Resize(context.CurrentWindow->Size.X, painterHeight);
+
+		// The content of a resized painter is undefined
+		context.CurrentWindow->ContentValid = false;
 	}
+	context.CurrentWindow->PainterSize = {context.CurrentWindow->Size.X, painterHeight};
+	context.CurrentWindow->ClipRect    = {0, 0, context.CurrentWindow->Size.X, painterHeight};
 
 	auto windowBarRectangle = HXRect{Profile.Position.X, Profile.Position.Y, Profile.Position.X + Profile.Size.X,
 	                                 Profile.Position.Y + 40};
@@ -56,8 +125,10 @@ void Window(const HXString &Title, WindowProfile &Profile) {
 		Profile.Position.X, Profile.Position.Y, Profile.Position.X + Profile.Size.X, Profile.Position.Y + Profile.Size.Y
 	};
 
-	// Judge the window drag operation
-	for (auto &Message : context.MessageQuery) {
+	// Judge the window drag operation, only the messages routed to the
+	// window are looked at
+	for (auto messageIndex : context.CurrentWindow->Inbox) {
+		auto &Message = context.MessageQuery[messageIndex];
 		if (Message.Processed) {
 			continue;
 		}
@@ -162,7 +233,8 @@ void Window(const HXString &Title, WindowProfile &Profile) {
 			needCursorStyle = true;
 		}
 
-		if (!needCursorStyle && !(Profile.InAllSize || Profile.InWidthSize || Profile.InHeightSize)) {
+		if (!needCursorStyle && !(Profile.InAllSize || Profile.InWidthSize || Profile.InHeightSize) &&
+		    Profile.InCursorStyling) {
 			Profile.InCursorStyling = false;
 			context.OSAPI->SetCursorStyle(HXCursorStyle::Normal);
 		}
@@ -189,6 +261,10 @@ void Window(const HXString &Title, WindowProfile &Profile) {
 
 	Profile.Size = context.CurrentWindow->Size;
 
+	context.CurrentWindow->Captured = Profile.InDrag || Profile.InAllSize || Profile.InWidthSize ||
+	                                  Profile.InHeightSize;
+	context.CurrentWindow->Tracking = Profile.InCursorStyling;
+
 	bool vertUseMax = Profile.MaxSize.X > 0;
 	bool horUseMax  = Profile.MaxSize.Y > 0;
 	bool vertUseMin = Profile.MinSize.X > 0;
@@ -216,30 +292,38 @@ void Window(const HXString &Title, WindowProfile &Profile) {
 		Profile.Size.Y = Profile.MinSize.Y;
 	}
 
-	const auto           rectangleHeight   = static_cast<HXGInt>(ceil(6 * sqrt(3) + 15));
-	std::vector<HXPoint> rectangleVertexes = {
+	const auto rectangleHeight   = static_cast<HXGInt>(ceil(6 * sqrt(3) + 15));
+	HXPoint    rectangleVertexes[] = {
 		{4, 15},
 		{16, 15},
 		{10, rectangleHeight},
 	};
 	if (Profile.Folded) {
-		rectangleVertexes = {
-			{4, rectangleHeight},
-			{16, rectangleHeight},
-			{10, 15},
-		};
+		rectangleVertexes[0] = {4, rectangleHeight};
+		rectangleVertexes[1] = {16, rectangleHeight};
+		rectangleVertexes[2] = {10, 15};
 	}
 	windowBarRectangle = HXRect{0, 0, Profile.Size.X, 40};
 
 	// Draw Title Bar
-	context.CurrentWindow->Painter->Begin();
-	context.CurrentWindow->Painter->Clear(theme.WindowBackground);
-	context.CurrentWindow->Painter->DrawFilledRectangle(windowBarRectangle, theme.WindowTitleBackground,
-	                                                    theme.WindowTitleBackground);
-	context.CurrentWindow->Painter->DrawFilledPolygon(rectangleVertexes, theme.WindowTitleText);
-	context.CurrentWindow->Painter->DrawText(Title, HXFont{}, {20, 10}, theme.WindowTitleText, 20);
-	context.CurrentWindow->Painter->End();
+	auto &drawList = context.CurrentWindow->DrawList;
+	drawList.AddClear(theme.WindowBackground);
+	drawList.AddFilledRectangle(windowBarRectangle, theme.WindowTitleBackground, theme.WindowTitleBackground);
+	drawList.AddFilledPolygon(rectangleVertexes, 3, theme.WindowTitleText);
+	drawList.AddText(Title, HXFontHandle{}, {20, 10}, theme.WindowTitleText, 20);
 
 	Profile.Position = context.CurrentWindow->Where;
 }
 }
+
+void Window(HXTitle Title, WindowProfile &Profile) {
+	_Window(_WindowID(GetContext(), Title), Title.Text, Profile);
+}
+
+void Window(HXTitle Title) {
+	auto &context = GetContext();
+
+	const auto id = _WindowID(context, Title);
+	_Window(id, Title.Text, context.WindowStates.Touch(id, context.Frame));
+}
+}
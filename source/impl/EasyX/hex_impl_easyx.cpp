@@ -27,9 +27,13 @@
 
 #include <algorithm>
 #include <include/impl/EasyX/hex_impl_easyx.h>
+#include <include/hex_measure_cache.h>
+#include <include/impl/hex_blend.h>
 
+#include <cstring>
 #include <graphics.h>
 #include <iterator>
+#include <type_traits>
 
 namespace HX {
 void Begin(HXContext *RenderContext);
@@ -61,40 +65,113 @@ void *GetHXBuffer(IMAGE *Buffer) {
 
 #define HXColorToEasyXColor(COLOR) (RGB(COLOR.R, COLOR.G, COLOR.B))
 
-/////////////////////////////////////////////
-/// HXBufferPainterImpl
-
-HXBufferPainterImpl::HXBufferPainterImpl(IMAGE *Buffer) {
-	_buffer = Buffer;
+namespace {
+HXGlyphAtlas &_EasyXGlyphAtlas() {
+	static HXGlyphAtlas atlas;
+	return atlas;
+}
 
-	setbkmode(TRANSPARENT);
+/**
+ * The widths GDI measures for the whole texts drawn from the atlas, a text
+ * is only measured the first time it is drawn in a font and a height
+ */
+HXMeasureCache &_EasyXTextWidths() {
+	static HXMeasureCache widths;
+	return widths;
 }
 
-void HXBufferPainterImpl::DrawLine(HXPoint Point1, HXPoint Point2, HXColor Color) {
-	setlinecolor(HXColorToEasyXColor(Color));
+/**
+ * The font last applied by settextstyle and the image it was applied to,
+ * together with the LOGFONT of every interned font which is built once
+ */
+struct _EasyXFontState {
+	IMAGE   *Target = nullptr;
+	uint32_t Font   = 0;
+	HXGUInt  Height = 0;
+
+	std::vector<LOGFONT> Fonts;
+	std::vector<bool>    Built;
+};
+
+_EasyXFontState &_GetEasyXFontState() {
+	static _EasyXFontState state;
+	return state;
+}
 
-	line(Point1.X, Point1.Y, Point2.X, Point2.Y);
+/**
+ * Forgetting the font applied to an image, which is needed whenever the
+ * image is recreated or may have been touched by the host
+ */
+void _ForgetEasyXFont(IMAGE *Image) {
+	auto &state = _GetEasyXFontState();
+	if (state.Target == Image) {
+		state.Target = nullptr;
+	}
 }
 
-void HXBufferPainterImpl::DrawRectangle(HXRect Rect, HXColor Color) {
-	setlinecolor(HXColorToEasyXColor(Color));
+/**
+ * Decoding the character at the front of a text, a DBCS or UTF-8 character
+ * of the ANSI code page and a surrogate pair of UTF-16 are decoded into a
+ * single code point
+ * @param Text The text to be decoded, which must not be empty
+ * @param Code The code point of the character
+ * @return The count of the units the character takes, or 0 when the text
+ * does not start with a valid character
+ */
+size_t _DecodeCharacter(HXStringView Text, HXGUInt &Code) {
+#ifdef UNICODE
+	const auto first = static_cast<HXGUInt>(static_cast<std::make_unsigned_t<wchar_t>>(Text[0]));
+	if (first < 0xD800 || first >= 0xE000) {
+		Code = first;
 
-	rectangle(Rect.Left, Rect.Top, Rect.Right, Rect.Bottom);
-}
+		return 1;
+	}
+	if (first >= 0xDC00 || Text.size() < 2) {
+		return 0;
+	}
 
-void HXBufferPainterImpl::DrawFilledRectangle(HXRect Rect, HXColor Color, HXColor FillColor) {
-	setlinecolor(HXColorToEasyXColor(Color));
-	setfillcolor(HXColorToEasyXColor(FillColor));
+	const auto second = static_cast<HXGUInt>(static_cast<std::make_unsigned_t<wchar_t>>(Text[1]));
+	if (second < 0xDC00 || second >= 0xE000) {
+		return 0;
+	}
+	Code = 0x10000 + ((first - 0xD800) << 10) + (second - 0xDC00);
 
-	solidrectangle(Rect.Left, Rect.Top, Rect.Right, Rect.Bottom);
-	rectangle(Rect.Left, Rect.Top, Rect.Right, Rect.Bottom);
-}
+	return 2;
+#else
+	const auto first = static_cast<unsigned char>(Text[0]);
+	if (first < 0x80) {
+		Code = first;
 
-void HXBufferPainterImpl::DrawPainter(HXBufferPainter *Painter, HXPoint Where) {
-	putimage(Where.X, Where.Y, static_cast<HXBufferPainterImpl *>(Painter)->_buffer);
+		return 1;
+	}
+
+	static const bool utf8   = GetACP() == CP_UTF8;
+	size_t            length = 1;
+	if (utf8) {
+		length = first >= 0xF0 ? 4 : first >= 0xE0 ? 3 : 2;
+	} else if (IsDBCSLeadByte(first)) {
+		length = 2;
+	}
+	if (length > Text.size()) {
+		return 0;
+	}
+
+	wchar_t   wide[2];
+	const int count = MultiByteToWideChar(CP_ACP, MB_ERR_INVALID_CHARS, Text.data(), static_cast<int>(length), wide,
+	                                      2);
+	if (count == 1) {
+		Code = static_cast<HXGUInt>(wide[0]);
+	} else if (count == 2) {
+		Code = 0x10000 + ((static_cast<HXGUInt>(wide[0]) - 0xD800) << 10) + (static_cast<HXGUInt>(wide[1]) - 0xDC00);
+	} else {
+		return 0;
+	}
+
+	return length;
+#endif
 }
 
-void HXBufferPainterImpl::SetupEasyXFont(HXFont Font, HXGUInt Height) {
+LOGFONT _BuildEasyXFont(const HXFont &Font) {
 	LOGFONT font;
 
 	gettextstyle(&font);
@@ -123,29 +200,272 @@ void HXBufferPainterImpl::SetupEasyXFont(HXFont Font, HXGUInt Height) {
 		font.lfWeight = FW_NORMAL;
 		break;
 	}
+
+	return font;
+}
+}
+
+/////////////////////////////////////////////
+/// HXBufferPainterImpl
+
+HXBufferPainterImpl::HXBufferPainterImpl(IMAGE *Buffer) {
+	_buffer = Buffer;
+	if (Buffer != nullptr) {
+		_width  = Buffer->getwidth();
+		_height = Buffer->getheight();
+	}
+
+	setbkmode(TRANSPARENT);
+}
+
+void HXBufferPainterImpl::DrawLine(HXPoint Point1, HXPoint Point2, HXColor Color) {
+	setlinecolor(HXColorToEasyXColor(Color));
+
+	line(Point1.X, Point1.Y, Point2.X, Point2.Y);
+}
+
+void HXBufferPainterImpl::DrawRectangle(HXRect Rect, HXColor Color) {
+	setlinecolor(HXColorToEasyXColor(Color));
+
+	rectangle(Rect.Left, Rect.Top, Rect.Right, Rect.Bottom);
+}
+
+void HXBufferPainterImpl::DrawFilledRectangle(HXRect Rect, HXColor Color, HXColor FillColor) {
+	setlinecolor(HXColorToEasyXColor(Color));
+	setfillcolor(HXColorToEasyXColor(FillColor));
+
+	solidrectangle(Rect.Left, Rect.Top, Rect.Right, Rect.Bottom);
+	rectangle(Rect.Left, Rect.Top, Rect.Right, Rect.Bottom);
+}
+
+void HXBufferPainterImpl::DrawPainter(HXBufferPainter *Painter, HXPoint Where) {
+	auto painter = static_cast<HXBufferPainterImpl *>(Painter);
+
+	putimage(Where.X, Where.Y, painter->_width, painter->_height, painter->_buffer, 0, 0);
+}
+
+void HXBufferPainterImpl::DrawPainterRegion(HXBufferPainter *Painter, HXPoint Where, HXRect Region,
+                                            HXColInt Opacity) {
+	auto       painter = static_cast<HXBufferPainterImpl *>(Painter);
+	const auto visible = Region.Intersect(Bounds()).Intersect(
+		{Where.X, Where.Y, Where.X + painter->_width, Where.Y + painter->_height});
+	if (visible.IsEmpty() || Opacity == 0) {
+		return;
+	}
+
+	if (Opacity == 255) {
+		putimage(visible.Left, visible.Top, visible.CalWidth(), visible.CalHeight(), painter->_buffer,
+		         visible.Left - Where.X, visible.Top - Where.Y);
+
+		return;
+	}
+
+	// The images have no alpha, so a translucent painter is mixed with the
+	// opacity alone, straight on the image buffers
+	const auto clipped = visible.Intersect({0, 0, _width, _height});
+	if (clipped.IsEmpty()) {
+		return;
+	}
+
+	DWORD       *target       = GetImageBuffer(_buffer);
+	const DWORD *source       = GetImageBuffer(painter->_buffer);
+	const HXGInt targetStride = _buffer->getwidth();
+	const HXGInt sourceStride = painter->_buffer->getwidth();
+	for (HXGInt y = clipped.Top; y < clipped.Bottom; ++y) {
+		HXMixRow(reinterpret_cast<uint32_t *>(target + static_cast<size_t>(y) * targetStride + clipped.Left),
+		         reinterpret_cast<const uint32_t *>(source + static_cast<size_t>(y - Where.Y) * sourceStride +
+		                                            (clipped.Left - Where.X)),
+		         static_cast<size_t>(clipped.CalWidth()), Opacity);
+	}
+}
+
+void HXBufferPainterImpl::SetupEasyXFont(HXFontHandle Font, HXGUInt Height) {
+	auto      &state  = _GetEasyXFontState();
+	IMAGE     *target = GetWorkingImage();
+	const auto index  = Font.Index();
+	if (state.Target == target && state.Font == index && state.Height == Height) {
+		return;
+	}
+
+	if (index >= state.Fonts.size()) {
+		state.Fonts.resize(index + 1);
+		state.Built.resize(index + 1, false);
+	}
+	if (!state.Built[index]) {
+		state.Fonts[index] = _BuildEasyXFont(Font.Font());
+		state.Built[index] = true;
+	}
+
+	LOGFONT font  = state.Fonts[index];
 	font.lfHeight = static_cast<LONG>(Height);
 
 	settextstyle(&font);
+
+	state.Target = target;
+	state.Font   = index;
+	state.Height = Height;
 }
 
-void HXBufferPainterImpl::DrawText(const HXString &Text, HXFont Font, HXPoint Where, HXColor Color, HXGUInt Height) {
-	SetupEasyXFont(Font, Height);
+const HXGlyph &HXBufferPainterImpl::RasterizeGlyph(const HXGlyphKey &Key, HXFontHandle Font,
+                                                   HXStringView Character) {
+	// GDI draws the glyph white on black into a scratch image, and the
+	// brightness of the result is taken as the coverage of the glyph
+	static IMAGE scratch(1, 1);
+
+	// A character takes four units at most
+	HXString::value_type character[5] = {};
+	std::copy_n(Character.data(), std::min<size_t>(Character.size(), 4), character);
+
+	SetWorkingImage(&scratch);
+	SetupEasyXFont(Font, Key.Height);
+
+	const HXGInt advance = textwidth(character);
+	const HXGInt height  = textheight(character);
+
+	// Leaving some room for the overhang of the italic glyphs
+	const HXGInt width = advance + height / 4;
+	if (scratch.getwidth() < width || scratch.getheight() < height) {
+		::Resize(&scratch, std::max(scratch.getwidth(), width), std::max(scratch.getheight(), height));
+		_ForgetEasyXFont(&scratch);
+		SetWorkingImage(&scratch);
+		SetupEasyXFont(Font, Key.Height);
+	}
+
+	setbkcolor(BLACK);
+	cleardevice();
+	setbkmode(TRANSPARENT);
+	settextcolor(WHITE);
+	outtextxy(0, 0, character);
+
+	const DWORD         *pixels = GetImageBuffer(&scratch);
+	const HXGInt         stride = scratch.getwidth();
+	std::vector<uint8_t> coverage(static_cast<size_t>(width) * height);
+	HXGInt               used = advance;
+	for (HXGInt y = 0; y < height; ++y) {
+		for (HXGInt x = 0; x < width; ++x) {
+			const DWORD pixel = pixels[static_cast<size_t>(y) * stride + x];
+			const auto  value = static_cast<uint8_t>(std::max({pixel & 0xFF, pixel >> 8 & 0xFF, pixel >> 16 & 0xFF}));
+
+			coverage[static_cast<size_t>(y) * width + x] = value;
+			if (value != 0) {
+				used = std::max(used, x + 1);
+			}
+		}
+	}
+
+	// Cropping the unused overhang columns
+	for (HXGInt y = 1; y < height && used < width; ++y) {
+		std::memmove(coverage.data() + static_cast<size_t>(y) * used, coverage.data() + static_cast<size_t>(y) * width,
+		             static_cast<size_t>(used));
+	}
+
+	SetWorkingImage(_buffer);
+	setbkmode(TRANSPARENT);
+
+	return _EasyXGlyphAtlas().Insert(Key, used, height, advance, coverage.data());
+}
+
+void HXBufferPainterImpl::BlitGlyph(const HXGlyph &Glyph, const uint8_t *Coverage, HXPoint Where, HXColor Color) {
+	const auto visible =
+		HXRect{Where.X, Where.Y, Where.X + Glyph.Width, Where.Y + Glyph.Height}.Intersect(Bounds());
+	if (visible.IsEmpty()) {
+		return;
+	}
+
+	// The image buffer stores the pixels as 0xRRGGBB
+	DWORD       *pixels = GetImageBuffer(_buffer);
+	const HXGInt stride = _buffer->getwidth();
+	const DWORD  color  = BGR(HXColorToEasyXColor(Color));
+	for (HXGInt y = visible.Top; y < visible.Bottom; ++y) {
+		const uint8_t *coverage = Coverage + static_cast<size_t>(y - Where.Y) * HXGlyphAtlas::Stride() - Where.X;
+		DWORD         *row      = pixels + static_cast<size_t>(y) * stride;
+		for (HXGInt x = visible.Left; x < visible.Right; ++x) {
+			const DWORD alpha = coverage[x];
+			if (alpha == 255) {
+				row[x] = color;
+			} else if (alpha != 0) {
+				const DWORD inverse = 255 - alpha;
+				const DWORD target  = row[x];
+
+				row[x] = ((color >> 16 & 0xFF) * alpha + (target >> 16 & 0xFF) * inverse) / 255 << 16 |
+				         ((color >> 8 & 0xFF) * alpha + (target >> 8 & 0xFF) * inverse) / 255 << 8 |
+				         ((color & 0xFF) * alpha + (target & 0xFF) * inverse) / 255;
+			}
+		}
+	}
+}
+
+void HXBufferPainterImpl::DrawText(HXStringView Text, HXFontHandle Font, HXPoint Where, HXColor Color,
+                                   HXGUInt Height) {
+	const auto bounds = Bounds();
+	if (Text.empty() || Where.Y >= bounds.Bottom || Where.Y + static_cast<HXGInt>(Height) <= bounds.Top) {
+		return;
+	}
+
+	// The glyphs are rasterized only once, drawing a text is then a series
+	// of blits from the atlas
+	auto      &atlas    = _EasyXGlyphAtlas();
+	const auto fontKey  = Font.Key();
+	bool       drawable = true;
+	HXGInt     advance  = 0;
+	_run.clear();
+	for (size_t index = 0; index < Text.size() && drawable;) {
+		HXGUInt      code   = 0;
+		const size_t length = _DecodeCharacter(Text.substr(index), code);
+		if (length == 0) {
+			drawable = false;
+
+			break;
+		}
+
+		const auto     key   = HXGlyphKey{.Font = fontKey, .Height = Height, .Code = code};
+		const HXGlyph *glyph = atlas.Find(key);
+		if (glyph == nullptr) {
+			// A flush of the atlas drops the glyphs already taken for the run
+			const size_t cached = atlas.Size();
+
+			glyph    = &RasterizeGlyph(key, Font, Text.substr(index, length));
+			drawable = atlas.Size() > cached;
+		}
+
+		_run.push_back(*glyph);
+		advance += glyph->Advance;
+		index += length;
+	}
+
+	// GDI measures a whole text differently from its characters when the
+	// font overhangs or adjusts the pairs of characters, such a text and
+	// the one the atlas can not decode are drawn by GDI, so the drawing
+	// always matches MeasureText
+	if (!drawable || advance != _EasyXTextWidths().Measure(this, Text, Font, Height).Right) {
+		SetupEasyXFont(Font, Height);
+		_terminated.assign(Text);
+		settextcolor(HXColorToEasyXColor(Color));
+		outtextxy(Where.X, Where.Y, _terminated.c_str());
+
+		return;
+	}
 
-	settextcolor(HXColorToEasyXColor(Color));
+	for (const auto &glyph : _run) {
+		if (Where.X >= bounds.Right) {
+			break;
+		}
 
-	outtextxy(Where.X, Where.Y, Text.c_str());
+		BlitGlyph(glyph, atlas.Coverage(glyph), Where, Color);
+
+		Where.X += glyph.Advance;
+	}
 }
 
-void HXBufferPainterImpl::DrawFilledPolygon(std::vector<HXPoint> Points, HXColor Color) {
+void HXBufferPainterImpl::DrawFilledPolygon(const HXPoint *Points, size_t Count, HXColor Color) {
 	setfillcolor(HXColorToEasyXColor(Color));
 
-	std::vector<POINT> points;
-	points.reserve(Points.size());
-	std::ranges::transform(Points, std::back_inserter(points), [](const HXPoint &Point) {
+	_polygon.clear();
+	std::transform(Points, Points + Count, std::back_inserter(_polygon), [](const HXPoint &Point) {
 		return POINT{static_cast<LONG>(Point.X), static_cast<LONG>(Point.Y)};
 	});
 
-	solidpolygon(points.data(), points.size());
+	solidpolygon(_polygon.data(), static_cast<int>(_polygon.size()));
 }
 
 void HXBufferPainterImpl::DrawFilledRoundedRectangle(HXRect Rect, HXColor Color, HXColor FillColor, HXGInt Radius) {
@@ -155,16 +475,52 @@ void HXBufferPainterImpl::DrawFilledRoundedRectangle(HXRect Rect, HXColor Color,
 	fillroundrect(Rect.Left, Rect.Top, Rect.Right, Rect.Bottom, Radius, Radius);
 }
 
-HXRect HXBufferPainterImpl::MeasureText(const HXString &Text, HXFont Font, HXGUInt Height) {
+HXRect HXBufferPainterImpl::MeasureText(HXStringView Text, HXFontHandle Font, HXGUInt Height) {
 	SetupEasyXFont(Font, Height);
 
-	return {.Left = 0, .Top = 0, .Right = textwidth(Text.c_str()), .Bottom = textheight(Text.c_str())};
+	// EasyX only measures terminated strings, the copy is only made for the
+	// texts missing the measurement cache
+	_terminated.assign(Text);
+
+	return {.Left = 0, .Top = 0, .Right = textwidth(_terminated.c_str()), .Bottom = textheight(_terminated.c_str())};
 }
 
 void HXBufferPainterImpl::Clear(HXColor Color) {
 	setbkcolor(HXColorToEasyXColor(Color));
+	if (!_clipped) {
+		cleardevice();
 
-	cleardevice();
+		return;
+	}
+
+	// Only the clipped part is cleared, the rectangles of EasyX include
+	// their right and bottom edges
+	const auto bounds = Bounds();
+	if (!bounds.IsEmpty()) {
+		setfillcolor(HXColorToEasyXColor(Color));
+		solidrectangle(bounds.Left, bounds.Top, bounds.Right - 1, bounds.Bottom - 1);
+	}
+}
+
+void HXBufferPainterImpl::SetClipRect(HXRect Rect) {
+	_clip    = Rect;
+	_clipped = true;
+
+	const auto region = CreateRectRgn(Rect.Left, Rect.Top, Rect.Right, Rect.Bottom);
+	setcliprgn(region);
+	DeleteObject(region);
+}
+
+void HXBufferPainterImpl::ResetClipRect() {
+	_clipped = false;
+
+	setcliprgn(NULL);
+}
+
+HXRect HXBufferPainterImpl::Bounds() const {
+	const auto surface = HXRect{0, 0, _width, _height};
+
+	return _clipped ? surface.Intersect(_clip) : surface;
 }
 
 HXBufferPainter *HXBufferPainterImpl::CreateSubPainter(HXGInt Width, HXGInt Height) {
@@ -177,6 +533,7 @@ HXBufferPainter *HXBufferPainterImpl::CreateFromBuffer(void *Buffer) {
 
 void HXBufferPainterImpl::Begin() {
 	SetWorkingImage(_buffer);
+	_ForgetEasyXFont(_buffer);
 
 	setbkmode(TRANSPARENT);
 }
@@ -185,17 +542,39 @@ void HXBufferPainterImpl::End() {
 	SetWorkingImage();
 }
 
+void HXBufferPainterImpl::Resize(HXGInt, HXGInt) {
+	// The image is owned by the host, which is the only one able to resize it
+}
+
 /////////////////////////////////////////////
 /// HXExHostedBufferPainterImpl
 
 HXExHostedBufferPainterImpl::HXExHostedBufferPainterImpl(HXGInt Width, HXGInt Height)
 	: HXBufferPainterImpl(new IMAGE(Width, Height)) {
+	_width  = Width;
+	_height = Height;
+
+	// The new image may reuse the address of a released one
+	_ForgetEasyXFont(_buffer);
 }
 
 HXExHostedBufferPainterImpl::~HXExHostedBufferPainterImpl() {
+	_ForgetEasyXFont(_buffer);
+
 	delete _buffer;
 }
 
+void HXExHostedBufferPainterImpl::Resize(HXGInt Width, HXGInt Height) {
+	_width  = Width;
+	_height = Height;
+
+	if (Width > _buffer->getwidth() || Height > _buffer->getheight()) {
+		::Resize(_buffer, std::max(HXPainterCapacity(Width), _buffer->getwidth()),
+		         std::max(HXPainterCapacity(Height), _buffer->getheight()));
+		_ForgetEasyXFont(_buffer);
+	}
+}
+
 /////////////////////////////////////////////
 /// HXContextImpl
 
@@ -233,6 +612,10 @@ HXMessage HXMessageSenderImpl::Message(void *Message) {
 	if (exMessage->message == WM_LBUTTONUP) {
 		message.MouseLeftRelease = true;
 	}
+	if (exMessage->message == WM_MOUSEWHEEL) {
+		message.MouseAction = true;
+		message.MouseWheel  = exMessage->wheel;
+	}
 	if (message.MouseAction) {
 		message.MouseX = exMessage->x;
 		message.MouseY = exMessage->y;
@@ -289,3 +672,12 @@ void HXOSOperationImpl::SetCursorStyle(HXCursorStyle Style) {
 	}
 	}
 }
+
+HXPeekResult HXOSOperationImpl::PeekInput() {
+	// The EasyX window pumps its messages on its own thread and offers no
+	// handle to wait on, so the queue is only peeked without removing
+	// anything
+	ExMessage message{};
+
+	return peekmessage(&message, -1, false) ? HXPeekResult::Input : HXPeekResult::Empty;
+}
@@ -0,0 +1,631 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * \file hex_impl_software.cpp
+ * \brief The HiEasyX impl of a headless CPU rasterizer
+ */
+
+#include <include/impl/Software/hex_impl_software.h>
+#include <include/impl/hex_blend.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define HEX_SOFTWARE_SSE2
+#endif
+
+namespace HX {
+void Begin(HXContext *RenderContext);
+
+void OSAPI(HXOSOperation *API);
+
+void MessageSender(HXMessageSender *Sender);
+
+void CreateTheme();
+
+// Every thread drives its own UI, so the implementation state is kept per
+// thread instead of being shared by the runtime contexts
+HXContextImpl &_SoftwareContext() {
+	thread_local HXContextImpl context;
+	return context;
+}
+
+void HXBegin() {
+	thread_local HXOSOperationImpl api;
+	Begin(&_SoftwareContext());
+	OSAPI(&api);
+}
+
+void HXInitForSoftware(HXSoftwareBuffer *Device) {
+	static HXMessageSenderImpl sender;
+	MessageSender(&sender);
+
+	_SoftwareContext().SetDevice(Device);
+
+	CreateTheme();
+}
+
+void *GetHXBuffer(HXSoftwareBuffer *Buffer) {
+	return static_cast<void *>(Buffer);
+}
+}
+
+namespace {
+/**
+ * The 5x7 bitmap glyphs for the printable ASCII range, each glyph is stored
+ * column by column and the lowest bit of a column is the top row
+ */
+constexpr uint8_t HXSoftwareGlyphs[][5] = {
+	{0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+	{0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+	{0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+	{0x00, 0x41, 0x22, 0x1C, 0x00}, {0x08, 0x2A, 0x1C, 0x2A, 0x08}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+	{0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x60, 0x60, 0x00, 0x00},
+	{0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+	{0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+	{0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+	{0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x36, 0x36, 0x00, 0x00},
+	{0x00, 0x56, 0x36, 0x00, 0x00}, {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14},
+	{0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06}, {0x32, 0x49, 0x79, 0x41, 0x3E},
+	{0x7E, 0x11, 0x11, 0x11, 0x7E}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+	{0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01},
+	{0x3E, 0x41, 0x49, 0x49, 0x7A}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+	{0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+	{0x7F, 0x02, 0x0C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+	{0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+	{0x46, 0x49, 0x49, 0x49, 0x31}, {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+	{0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+	{0x07, 0x08, 0x70, 0x08, 0x07}, {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},
+	{0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00}, {0x04, 0x02, 0x01, 0x02, 0x04},
+	{0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78},
+	{0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20}, {0x38, 0x44, 0x44, 0x48, 0x7F},
+	{0x38, 0x54, 0x54, 0x54, 0x18}, {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x0C, 0x52, 0x52, 0x52, 0x3E},
+	{0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x44, 0x3D, 0x00},
+	{0x7F, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78},
+	{0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0x7C, 0x14, 0x14, 0x14, 0x08},
+	{0x08, 0x14, 0x14, 0x18, 0x7C}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+	{0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C},
+	{0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C},
+	{0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x7F, 0x00, 0x00},
+	{0x00, 0x41, 0x36, 0x08, 0x00}, {0x08, 0x04, 0x08, 0x10, 0x08},
+};
+
+constexpr HXGUInt HXSoftwareGlyphFirst  = 0x20;
+constexpr HXGUInt HXSoftwareGlyphLast   = 0x7E;
+constexpr HXGInt  HXSoftwareGlyphCellX  = 6;
+constexpr HXGInt  HXSoftwareGlyphCellY  = 8;
+constexpr HXGInt  HXSoftwareGlyphWidth  = 5;
+constexpr HXGInt  HXSoftwareGlyphHeight = 7;
+
+HXGInt _GlyphAdvance(HXGInt Height) {
+	return std::max<HXGInt>(1, (Height * HXSoftwareGlyphCellX + HXSoftwareGlyphCellY / 2) / HXSoftwareGlyphCellY);
+}
+
+/**
+ * Getting how many pixels the synthesized weight widens the strokes of a glyph
+ */
+HXGInt _GlyphWeight(const HXFont &Font, HXGInt Height) {
+	switch (Font.Style) {
+	case HXFontStyle::Bold:
+		return std::max<HXGInt>(1, Height / 16);
+	case HXFontStyle::Black:
+		return std::max<HXGInt>(2, Height / 10);
+	default:
+		return 0;
+	}
+}
+
+/**
+ * Getting how far the synthesized italic shears the top row of a glyph
+ */
+HXGInt _GlyphSlant(const HXFont &Font, HXGInt Height) {
+	return Font.Italic ? (Height - 1) * 3 / 16 : 0;
+}
+
+/**
+ * Filling Count pixels from Row with the same color, the store is done
+ * four pixels at once when SSE2 is available
+ */
+void _FillPixels(HXBuffer *Row, HXGInt Count, HXColor Color) {
+	HXGInt index = 0;
+#ifdef HEX_SOFTWARE_SSE2
+	uint32_t packed;
+	std::memcpy(&packed, &Color, sizeof(packed));
+
+	const __m128i wide = _mm_set1_epi32(static_cast<int>(packed));
+	for (; index + 8 <= Count; index += 8) {
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(Row + index), wide);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(Row + index + 4), wide);
+	}
+	for (; index + 4 <= Count; index += 4) {
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(Row + index), wide);
+	}
+#endif
+	std::fill(Row + index, Row + Count, Color);
+}
+
+HXGlyphAtlas &_SoftwareGlyphAtlas() {
+	// The threads rasterize into their own atlas, so drawing texts never
+	// needs a lock
+	thread_local HXGlyphAtlas atlas;
+	return atlas;
+}
+
+/**
+ * Rasterizing a glyph of the bitmap font into the atlas, the bitmap is
+ * scaled to the height and the weight and the italic are synthesized
+ */
+const HXGlyph &_RasterizeGlyph(HXGlyphAtlas &Atlas, const HXGlyphKey &Key, const HXFont &Font, HXGInt Height) {
+	const HXGUInt code  = Key.Code < HXSoftwareGlyphFirst || Key.Code > HXSoftwareGlyphLast ? '?' : Key.Code;
+	const auto   &glyph = HXSoftwareGlyphs[code - HXSoftwareGlyphFirst];
+
+	// Italic is a plain shear towards the right of the glyph top
+	const HXGInt weight   = _GlyphWeight(Font, Height);
+	const HXGInt advance  = _GlyphAdvance(Height);
+	const HXGInt maxSlant = _GlyphSlant(Font, Height);
+	const HXGInt width    = advance + weight + maxSlant;
+
+	HXVector<uint8_t, HXMemoryTag::Text> coverage(static_cast<size_t>(width) * Height);
+	for (HXGInt y = 0; y < Height; ++y) {
+		const HXGInt row = y * HXSoftwareGlyphCellY / Height;
+		if (row >= HXSoftwareGlyphHeight) {
+			continue;
+		}
+
+		const HXGInt slant = Font.Italic ? (Height - 1 - y) * 3 / 16 : 0;
+		for (HXGInt x = 0; x < advance; ++x) {
+			const HXGInt column = x * HXSoftwareGlyphCellX / advance;
+			if (column < HXSoftwareGlyphWidth && (glyph[column] >> row & 1)) {
+				std::fill_n(coverage.begin() + static_cast<ptrdiff_t>(y) * width + x + slant, weight + 1, 255);
+			}
+		}
+	}
+
+	return Atlas.Insert(Key, width, Height, advance, coverage.data());
+}
+}
+
+/////////////////////////////////////////////
+/// HXBufferPainterImpl
+
+HXBufferPainterImpl::HXBufferPainterImpl(HXSoftwareBuffer *Buffer) : _buffer(Buffer) {
+}
+
+const HXSoftwareBuffer &HXBufferPainterImpl::Surface() const {
+	return *_buffer;
+}
+
+HXRect HXBufferPainterImpl::Bounds() const {
+	const auto surface = HXRect{0, 0, _buffer->Width, _buffer->Height};
+
+	return _clipped ? surface.Intersect(_clip) : surface;
+}
+
+void HXBufferPainterImpl::FillSpan(HXGInt Y, HXGInt Left, HXGInt Right, HXColor Color) {
+	const auto bounds = Bounds();
+	if (Y < bounds.Top || Y >= bounds.Bottom) {
+		return;
+	}
+
+	Left  = std::max<HXGInt>(Left, bounds.Left);
+	Right = std::min<HXGInt>(Right, bounds.Right - 1);
+	if (Left > Right) {
+		return;
+	}
+
+	// The drawing colors are opaque as on the other implementations, only
+	// the clear color carries alpha
+	Color.A = 255;
+	_FillPixels(_buffer->Pixels + static_cast<size_t>(Y) * _buffer->Width + Left, Right - Left + 1, Color);
+}
+
+void HXBufferPainterImpl::PlotPixel(HXGInt X, HXGInt Y, HXColor Color) {
+	const auto bounds = Bounds();
+	if (X < bounds.Left || Y < bounds.Top || X >= bounds.Right || Y >= bounds.Bottom) {
+		return;
+	}
+
+	Color.A = 255;
+	_buffer->Pixels[static_cast<size_t>(Y) * _buffer->Width + X] = Color;
+}
+
+void HXBufferPainterImpl::DrawLine(HXPoint Point1, HXPoint Point2, HXColor Color) {
+	if (Point1.Y == Point2.Y) {
+		FillSpan(Point1.Y, std::min(Point1.X, Point2.X), std::max(Point1.X, Point2.X), Color);
+
+		return;
+	}
+
+	// Bresenham, every pixel is clipped on its own since the lines drawn
+	// by the UI are short
+	HXGInt deltaX = std::abs(Point2.X - Point1.X);
+	HXGInt deltaY = -std::abs(Point2.Y - Point1.Y);
+	HXGInt stepX  = Point1.X < Point2.X ? 1 : -1;
+	HXGInt stepY  = Point1.Y < Point2.Y ? 1 : -1;
+	HXGInt error  = deltaX + deltaY;
+
+	while (true) {
+		PlotPixel(Point1.X, Point1.Y, Color);
+		if (Point1.X == Point2.X && Point1.Y == Point2.Y) {
+			break;
+		}
+
+		const HXGInt doubled = error * 2;
+		if (doubled >= deltaY) {
+			error += deltaY;
+			Point1.X += stepX;
+		}
+		if (doubled <= deltaX) {
+			error += deltaX;
+			Point1.Y += stepY;
+		}
+	}
+}
+
+void HXBufferPainterImpl::DrawRectangle(HXRect Rect, HXColor Color) {
+	FillSpan(Rect.Top, Rect.Left, Rect.Right, Color);
+	FillSpan(Rect.Bottom, Rect.Left, Rect.Right, Color);
+
+	const HXGInt top    = std::max<HXGInt>(Rect.Top + 1, 0);
+	const HXGInt bottom = std::min<HXGInt>(Rect.Bottom - 1, _buffer->Height - 1);
+	for (HXGInt y = top; y <= bottom; ++y) {
+		PlotPixel(Rect.Left, y, Color);
+		PlotPixel(Rect.Right, y, Color);
+	}
+}
+
+void HXBufferPainterImpl::DrawFilledRectangle(HXRect Rect, HXColor Color, HXColor FillColor) {
+	const HXGInt top    = std::max<HXGInt>(Rect.Top, 0);
+	const HXGInt bottom = std::min<HXGInt>(Rect.Bottom, _buffer->Height - 1);
+	for (HXGInt y = top; y <= bottom; ++y) {
+		FillSpan(y, Rect.Left, Rect.Right, FillColor);
+	}
+
+	DrawRectangle(Rect, Color);
+}
+
+void HXBufferPainterImpl::DrawPainter(HXBufferPainter *Painter, HXPoint Where) {
+	DrawPainterRegion(Painter, Where, {0, 0, _buffer->Width, _buffer->Height}, 255);
+}
+
+void HXBufferPainterImpl::DrawPainterRegion(HXBufferPainter *Painter, HXPoint Where, HXRect Region,
+                                            HXColInt Opacity) {
+	const auto &source  = *static_cast<HXBufferPainterImpl *>(Painter)->_buffer;
+	const auto  visible = Region.Intersect(Bounds())
+	                     .Intersect({Where.X, Where.Y, Where.X + source.Width, Where.Y + source.Height});
+	if (visible.IsEmpty()) {
+		return;
+	}
+
+	if (Opacity == 0) {
+		return;
+	}
+
+	// The pixels are premultiplied, so the opaque runs of a row are plain
+	// copies inside the blending kernel
+	const auto rowPixels = static_cast<size_t>(visible.CalWidth());
+	for (HXGInt y = visible.Top; y < visible.Bottom; ++y) {
+		HXBlendRow(_buffer->Pixels + static_cast<size_t>(y) * _buffer->Width + visible.Left,
+		           source.Pixels + static_cast<size_t>(y - Where.Y) * source.Width + (visible.Left - Where.X),
+		           rowPixels, Opacity);
+	}
+}
+
+void HXBufferPainterImpl::BlitGlyph(const HXGlyph &Glyph, const uint8_t *Coverage, HXPoint Where, HXColor Color) {
+	const auto visible =
+		HXRect{Where.X, Where.Y, Where.X + Glyph.Width, Where.Y + Glyph.Height}.Intersect(Bounds());
+	if (visible.IsEmpty()) {
+		return;
+	}
+
+	for (HXGInt y = visible.Top; y < visible.Bottom; ++y) {
+		const uint8_t *coverage = Coverage + static_cast<size_t>(y - Where.Y) * HXGlyphAtlas::Stride() - Where.X;
+		HXBuffer      *row      = _buffer->Pixels + static_cast<size_t>(y) * _buffer->Width;
+		for (HXGInt x = visible.Left; x < visible.Right; ++x) {
+			const HXGUInt alpha = coverage[x];
+			if (alpha == 255) {
+				row[x] = {Color.R, Color.G, Color.B, 255};
+			} else if (alpha != 0) {
+				const HXGUInt inverse = 255 - alpha;
+
+				row[x].R = static_cast<HXColInt>((Color.R * alpha + row[x].R * inverse) / 255);
+				row[x].G = static_cast<HXColInt>((Color.G * alpha + row[x].G * inverse) / 255);
+				row[x].B = static_cast<HXColInt>((Color.B * alpha + row[x].B * inverse) / 255);
+				row[x].A = static_cast<HXColInt>((255 * alpha + row[x].A * inverse) / 255);
+			}
+		}
+	}
+}
+
+void HXBufferPainterImpl::DrawText(HXStringView Text, HXFontHandle Font, HXPoint Where, HXColor Color,
+                                   HXGUInt Height) {
+	const auto height = static_cast<HXGInt>(Height);
+	if (height <= 0) {
+		return;
+	}
+
+	// A text entirely above or below the drawable rows leaves nothing to blit
+	const auto bounds = Bounds();
+	if (Where.Y >= bounds.Bottom || Where.Y + height <= bounds.Top) {
+		return;
+	}
+
+	auto      &atlas   = _SoftwareGlyphAtlas();
+	const auto fontKey = Font.Key();
+	for (auto character : Text) {
+		if (Where.X >= bounds.Right) {
+			break;
+		}
+
+		const auto     key   = HXGlyphKey{.Font = fontKey, .Height = Height, .Code = static_cast<HXGUInt>(character)};
+		const HXGlyph *glyph = atlas.Find(key);
+		if (glyph == nullptr) {
+			glyph = &_RasterizeGlyph(atlas, key, Font.Font(), height);
+		}
+
+		BlitGlyph(*glyph, atlas.Coverage(*glyph), Where, Color);
+
+		Where.X += glyph->Advance;
+	}
+}
+
+void HXBufferPainterImpl::DrawFilledPolygon(const HXPoint *Points, size_t Count, HXColor Color) {
+	if (Count < 3) {
+		return;
+	}
+
+	HXGInt top    = Points[0].Y;
+	HXGInt bottom = Points[0].Y;
+	for (size_t index = 1; index < Count; ++index) {
+		top    = std::min(top, Points[index].Y);
+		bottom = std::max(bottom, Points[index].Y);
+	}
+	top    = std::max<HXGInt>(top, 0);
+	bottom = std::min<HXGInt>(bottom, _buffer->Height - 1);
+
+	// Even-odd scanline fill sampled at the pixel centers
+	for (HXGInt y = top; y <= bottom; ++y) {
+		const float sample = static_cast<float>(y) + 0.5f;
+
+		_crossings.clear();
+		for (size_t index = 0; index < Count; ++index) {
+			const auto &from = Points[index];
+			const auto &to   = Points[(index + 1) % Count];
+			if ((static_cast<float>(from.Y) <= sample) == (static_cast<float>(to.Y) <= sample)) {
+				continue;
+			}
+
+			const float x = static_cast<float>(from.X) + (sample - static_cast<float>(from.Y)) *
+			                static_cast<float>(to.X - from.X) / static_cast<float>(to.Y - from.Y);
+			_crossings.push_back(static_cast<HXGInt>(std::ceil(x - 0.5f)));
+		}
+
+		std::sort(_crossings.begin(), _crossings.end());
+		for (size_t index = 0; index + 1 < _crossings.size(); index += 2) {
+			FillSpan(y, _crossings[index], _crossings[index + 1] - 1, Color);
+		}
+	}
+}
+
+void HXBufferPainterImpl::DrawFilledRoundedRectangle(HXRect Rect, HXColor Color, HXColor FillColor, HXGInt Radius) {
+	// The radius follows the EasyX convention, which is the size of the
+	// ellipse in the corner instead of the real radius
+	const HXGInt radius = std::min({Radius / 2, Rect.CalWidth() / 2, Rect.CalHeight() / 2});
+	if (radius <= 0) {
+		DrawFilledRectangle(Rect, Color, FillColor);
+
+		return;
+	}
+
+	const HXGInt top    = std::max<HXGInt>(Rect.Top, 0);
+	const HXGInt bottom = std::min<HXGInt>(Rect.Bottom, _buffer->Height - 1);
+	for (HXGInt y = top; y <= bottom; ++y) {
+		HXGInt inset = 0;
+		HXGInt edge  = std::min(y - Rect.Top, Rect.Bottom - y);
+		if (edge < radius) {
+			const float delta = static_cast<float>(radius - edge) - 0.5f;
+			inset             = radius - static_cast<HXGInt>(std::sqrt(static_cast<float>(radius * radius) -
+			                                                           delta * delta));
+		}
+
+		if (edge == 0) {
+			FillSpan(y, Rect.Left + inset, Rect.Right - inset, Color);
+		} else {
+			FillSpan(y, Rect.Left + inset, Rect.Right - inset, FillColor);
+			PlotPixel(Rect.Left + inset, y, Color);
+			PlotPixel(Rect.Right - inset, y, Color);
+		}
+	}
+}
+
+HXRect HXBufferPainterImpl::MeasureText(HXStringView Text, HXFontHandle Font, HXGUInt Height) {
+	const auto height = static_cast<HXGInt>(Height);
+	if (Text.empty() || height <= 0) {
+		return {.Left = 0, .Top = 0, .Right = 0, .Bottom = std::max<HXGInt>(height, 0)};
+	}
+
+	// The glyphs advance by the plain cell, but the strokes of the last one
+	// still stick out by the synthesized weight and the italic shear
+	const auto &font = Font.Font();
+
+	return {.Left   = 0,
+	        .Top    = 0,
+	        .Right  = _GlyphAdvance(height) * static_cast<HXGInt>(Text.size()) + _GlyphWeight(font, height) +
+	                 _GlyphSlant(font, height),
+	        .Bottom = height};
+}
+
+void HXBufferPainterImpl::Clear(HXColor Color) {
+	if (_buffer->Pixels == nullptr) {
+		return;
+	}
+
+	// The pixels are stored premultiplied, so a translucent background is
+	// composited correctly onto the target
+	if (!_clipped) {
+		_FillPixels(_buffer->Pixels, _buffer->Width * _buffer->Height, HXPremultiply(Color));
+
+		return;
+	}
+
+	const auto bounds = Bounds();
+	if (bounds.IsEmpty()) {
+		return;
+	}
+	for (HXGInt y = bounds.Top; y < bounds.Bottom; ++y) {
+		_FillPixels(_buffer->Pixels + static_cast<size_t>(y) * _buffer->Width + bounds.Left, bounds.CalWidth(),
+		            HXPremultiply(Color));
+	}
+}
+
+void HXBufferPainterImpl::SetClipRect(HXRect Rect) {
+	_clip    = Rect;
+	_clipped = true;
+}
+
+void HXBufferPainterImpl::ResetClipRect() {
+	_clipped = false;
+}
+
+HXBufferPainter *HXBufferPainterImpl::CreateSubPainter(HXGInt Width, HXGInt Height) {
+	return new HXExHostedBufferPainterImpl(Width, Height);
+}
+
+HXBufferPainter *HXBufferPainterImpl::CreateFromBuffer(void *Buffer) {
+	return new HXBufferPainterImpl(static_cast<HXSoftwareBuffer *>(Buffer));
+}
+
+void HXBufferPainterImpl::Begin() {
+}
+
+void HXBufferPainterImpl::End() {
+}
+
+void HXBufferPainterImpl::Resize(HXGInt, HXGInt) {
+	// The surface is owned by the host, which is the only one able to resize it
+}
+
+/////////////////////////////////////////////
+/// HXExHostedBufferPainterImpl
+
+HXExHostedBufferPainterImpl::HXExHostedBufferPainterImpl(HXGInt Width, HXGInt Height)
+	: HXBufferPainterImpl(&_hosted) {
+	Resize(Width, Height);
+}
+
+void HXExHostedBufferPainterImpl::Resize(HXGInt Width, HXGInt Height) {
+	_hosted.Width  = std::max<HXGInt>(Width, 0);
+	_hosted.Height = std::max<HXGInt>(Height, 0);
+
+	// The rows are packed by the logical width, so any size fitting into the
+	// allocated pixels can be reused without reallocation, the headroom is
+	// only reserved once the painter actually has to grow
+	const auto required = static_cast<size_t>(_hosted.Width) * _hosted.Height;
+	if (required > _capacity) {
+		_capacity = _pixels == nullptr
+			            ? required
+			            : static_cast<size_t>(HXPainterCapacity(_hosted.Width)) * HXPainterCapacity(_hosted.Height);
+
+		_pixels.reset();
+		_pixels = HXAllocateArray<HXBuffer, HXMemoryTag::Painter>(_capacity);
+		std::fill_n(_pixels.get(), _capacity, HXBuffer{});
+
+		_hosted.Pixels = _pixels.get();
+	}
+}
+
+/////////////////////////////////////////////
+/// HXContextImpl
+
+HXContextImpl::HXContextImpl() : _defaultPainter(std::make_unique<HXBufferPainterImpl>(&_empty)) {
+}
+
+HXBufferPainter *HXContextImpl::DefaultPainter() {
+	return _defaultPainter.get();
+}
+
+HXBufferPainter *HXContextImpl::BufferToPainter(void *Buffer) {
+	return new HXBufferPainterImpl(static_cast<HXSoftwareBuffer *>(Buffer));
+}
+
+HXBuffer *HXContextImpl::GetDeviceBuffer() {
+	return _device != nullptr ? _device->Pixels : nullptr;
+}
+
+bool HXContextImpl::ParallelPainting() {
+	// Every painter owns its pixels and the glyphs are cached per thread
+	return true;
+}
+
+void HXContextImpl::SetDevice(HXSoftwareBuffer *Device) {
+	_device = Device;
+}
+
+/////////////////////////////////////////////
+/// HXMessageSenderImpl
+
+HXMessage HXMessageSenderImpl::Message(void *Message) {
+	HXMessage message{};
+	auto      softwareMessage = static_cast<HXSoftwareMessage *>(Message);
+
+	message.MouseAction = true;
+	message.MouseX      = softwareMessage->X;
+	message.MouseY      = softwareMessage->Y;
+	if (softwareMessage->Type == HXSoftwareMessageType::MouseLeftDown) {
+		message.MouseLeftPressed = true;
+	}
+	if (softwareMessage->Type == HXSoftwareMessageType::MouseLeftUp) {
+		message.MouseLeftRelease = true;
+	}
+	if (softwareMessage->Type == HXSoftwareMessageType::MouseWheel) {
+		message.MouseWheel = softwareMessage->Wheel;
+	}
+
+	return message;
+}
+
+////////////////////////////////////////////
+/// Global
+
+namespace HX {
+void *GetHXMessage(HXSoftwareMessage *Message) {
+	return static_cast<void *>(Message);
+}
+}
+
+void HXOSOperationImpl::SetCursorStyle(HXCursorStyle Style) {
+	_style = Style;
+}
+
+HXPeekResult HXOSOperationImpl::PeekInput() {
+	// The host pushes the input itself, HX::WaitForEvents waits for the
+	// pushed messages instead
+	return HXPeekResult::Unsupported;
+}
+
+HXCursorStyle HXOSOperationImpl::CursorStyle() const {
+	return _style;
+}
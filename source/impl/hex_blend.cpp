@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/**
+ * \file hex_blend.cpp
+ * \brief The pixel blending kernels shared by the implementations
+ */
+
+#include <include/impl/hex_blend.h>
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define HEX_BLEND_SSE2
+#endif
+
+// The AVX2 kernel is always compiled on x86 and only selected at runtime,
+// so the library still runs on the processors without AVX2
+#if defined(HEX_BLEND_SSE2) && (defined(__GNUC__) || defined(_MSC_VER))
+#	include <immintrin.h>
+#	define HEX_BLEND_AVX2
+#	if defined(__GNUC__) || defined(__clang__)
+#		define HEX_BLEND_TARGET_AVX2 __attribute__((target("avx2")))
+#	else
+#		include <intrin.h>
+#		define HEX_BLEND_TARGET_AVX2
+#	endif
+#endif
+
+namespace {
+/**
+ * Dividing by 255 with rounding, exact for every product of two bytes. The
+ * vector kernels use the same formula, so every kernel gives the same pixels
+ */
+constexpr uint32_t _Div255(uint32_t Value) {
+	Value += 128;
+
+	return (Value + (Value >> 8)) >> 8;
+}
+
+void _BlendScalar(HXBuffer *Target, const HXBuffer *Source, size_t Count, HXColInt Opacity) {
+	for (size_t index = 0; index < Count; ++index) {
+		auto source = Source[index];
+		if (Opacity != 255) {
+			source = {static_cast<HXColInt>(_Div255(source.R * Opacity)),
+			          static_cast<HXColInt>(_Div255(source.G * Opacity)),
+			          static_cast<HXColInt>(_Div255(source.B * Opacity)),
+			          static_cast<HXColInt>(_Div255(source.A * Opacity))};
+		}
+		if (source.A == 255) {
+			Target[index] = source;
+
+			continue;
+		}
+
+		auto         &target  = Target[index];
+		const uint32_t inverse = 255 - source.A;
+
+		target.R = static_cast<HXColInt>(std::min<uint32_t>(source.R + _Div255(target.R * inverse), 255));
+		target.G = static_cast<HXColInt>(std::min<uint32_t>(source.G + _Div255(target.G * inverse), 255));
+		target.B = static_cast<HXColInt>(std::min<uint32_t>(source.B + _Div255(target.B * inverse), 255));
+		target.A = static_cast<HXColInt>(std::min<uint32_t>(source.A + _Div255(target.A * inverse), 255));
+	}
+}
+
+void _MixScalar(uint32_t *Target, const uint32_t *Source, size_t Count, HXColInt Opacity) {
+	const uint32_t inverse = 255 - Opacity;
+	for (size_t index = 0; index < Count; ++index) {
+		uint32_t mixed = 0;
+		for (uint32_t shift = 0; shift < 32; shift += 8) {
+			const uint32_t source = Source[index] >> shift & 0xFF;
+			const uint32_t target = Target[index] >> shift & 0xFF;
+
+			mixed |= _Div255(source * Opacity + target * inverse) << shift;
+		}
+		Target[index] = mixed;
+	}
+}
+
+#ifdef HEX_BLEND_SSE2
+__m128i _Div255Epi16(__m128i Value) {
+	Value = _mm_add_epi16(Value, _mm_set1_epi16(128));
+
+	return _mm_srli_epi16(_mm_add_epi16(Value, _mm_srli_epi16(Value, 8)), 8);
+}
+
+/**
+ * Blending four pixels at once, every pixel is widened to four 16 bits
+ * lanes so the products of two bytes fit
+ */
+void _BlendSSE2(HXBuffer *Target, const HXBuffer *Source, size_t Count, HXColInt Opacity) {
+	const __m128i zero      = _mm_setzero_si128();
+	const __m128i full      = _mm_set1_epi16(255);
+	const __m128i opacity   = _mm_set1_epi16(Opacity);
+	const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+	size_t index = 0;
+	for (; index + 4 <= Count; index += 4) {
+		__m128i source     = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Source + index));
+		__m128i sourceLow  = _mm_unpacklo_epi8(source, zero);
+		__m128i sourceHigh = _mm_unpackhi_epi8(source, zero);
+		if (Opacity != 255) {
+			sourceLow  = _Div255Epi16(_mm_mullo_epi16(sourceLow, opacity));
+			sourceHigh = _Div255Epi16(_mm_mullo_epi16(sourceHigh, opacity));
+			source     = _mm_packus_epi16(sourceLow, sourceHigh);
+		}
+
+		// The opaque and the empty pixels are common, such runs skip the
+		// arithmetic
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(source, alphaMask), alphaMask)) == 0xFFFF) {
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(Target + index), source);
+
+			continue;
+		}
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(source, zero)) == 0xFFFF) {
+			continue;
+		}
+
+		const __m128i inverseLow  = _mm_sub_epi16(full, _mm_shufflehi_epi16(_mm_shufflelo_epi16(sourceLow, 0xFF), 0xFF));
+		const __m128i inverseHigh = _mm_sub_epi16(full, _mm_shufflehi_epi16(_mm_shufflelo_epi16(sourceHigh, 0xFF), 0xFF));
+
+		const __m128i target     = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Target + index));
+		const __m128i targetLow  = _Div255Epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(target, zero), inverseLow));
+		const __m128i targetHigh = _Div255Epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(target, zero), inverseHigh));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(Target + index),
+		                 _mm_adds_epu8(source, _mm_packus_epi16(targetLow, targetHigh)));
+	}
+
+	_BlendScalar(Target + index, Source + index, Count - index, Opacity);
+}
+
+void _MixSSE2(uint32_t *Target, const uint32_t *Source, size_t Count, HXColInt Opacity) {
+	const __m128i zero    = _mm_setzero_si128();
+	const __m128i opacity = _mm_set1_epi16(Opacity);
+	const __m128i inverse = _mm_set1_epi16(static_cast<short>(255 - Opacity));
+
+	size_t index = 0;
+	for (; index + 4 <= Count; index += 4) {
+		const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Source + index));
+		const __m128i target = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Target + index));
+
+		const __m128i low  = _Div255Epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(source, zero), opacity),
+		                                                _mm_mullo_epi16(_mm_unpacklo_epi8(target, zero), inverse)));
+		const __m128i high = _Div255Epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(source, zero), opacity),
+		                                                _mm_mullo_epi16(_mm_unpackhi_epi8(target, zero), inverse)));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(Target + index), _mm_packus_epi16(low, high));
+	}
+
+	_MixScalar(Target + index, Source + index, Count - index, Opacity);
+}
+#endif
+
+#ifdef HEX_BLEND_AVX2
+HEX_BLEND_TARGET_AVX2 __m256i _Div255Epi16x2(__m256i Value) {
+	Value = _mm256_add_epi16(Value, _mm256_set1_epi16(128));
+
+	return _mm256_srli_epi16(_mm256_add_epi16(Value, _mm256_srli_epi16(Value, 8)), 8);
+}
+
+/**
+ * The AVX2 version of _BlendSSE2 taking eight pixels at once, the unpacking
+ * and the packing both work inside the 128 bits halves, so the order of the
+ * pixels is kept
+ */
+HEX_BLEND_TARGET_AVX2 void _BlendAVX2(HXBuffer *Target, const HXBuffer *Source, size_t Count, HXColInt Opacity) {
+	const __m256i zero      = _mm256_setzero_si256();
+	const __m256i full      = _mm256_set1_epi16(255);
+	const __m256i opacity   = _mm256_set1_epi16(Opacity);
+	const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+
+	size_t index = 0;
+	for (; index + 8 <= Count; index += 8) {
+		__m256i source     = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(Source + index));
+		__m256i sourceLow  = _mm256_unpacklo_epi8(source, zero);
+		__m256i sourceHigh = _mm256_unpackhi_epi8(source, zero);
+		if (Opacity != 255) {
+			sourceLow  = _Div255Epi16x2(_mm256_mullo_epi16(sourceLow, opacity));
+			sourceHigh = _Div255Epi16x2(_mm256_mullo_epi16(sourceHigh, opacity));
+			source     = _mm256_packus_epi16(sourceLow, sourceHigh);
+		}
+
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(source, alphaMask), alphaMask)) == -1) {
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(Target + index), source);
+
+			continue;
+		}
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(source, zero)) == -1) {
+			continue;
+		}
+
+		const __m256i inverseLow =
+			_mm256_sub_epi16(full, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(sourceLow, 0xFF), 0xFF));
+		const __m256i inverseHigh =
+			_mm256_sub_epi16(full, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(sourceHigh, 0xFF), 0xFF));
+
+		const __m256i target    = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(Target + index));
+		const __m256i targetLow = _Div255Epi16x2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(target, zero), inverseLow));
+		const __m256i targetHigh =
+			_Div255Epi16x2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(target, zero), inverseHigh));
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(Target + index),
+		                    _mm256_adds_epu8(source, _mm256_packus_epi16(targetLow, targetHigh)));
+	}
+
+	_BlendSSE2(Target + index, Source + index, Count - index, Opacity);
+}
+
+bool _SupportsAVX2() {
+#	if defined(__GNUC__) || defined(__clang__)
+	return __builtin_cpu_supports("avx2");
+#	else
+	int info[4];
+	__cpuid(info, 1);
+
+	// The operating system has to save the YMM registers as well
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx     = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) {
+		return false;
+	}
+
+	__cpuidex(info, 7, 0);
+
+	return (info[1] & (1 << 5)) != 0;
+#	endif
+}
+#endif
+
+using _BlendKernel = void (*)(HXBuffer *, const HXBuffer *, size_t, HXColInt);
+
+_BlendKernel _SelectBlendKernel() {
+#ifdef HEX_BLEND_AVX2
+	if (_SupportsAVX2()) {
+		return _BlendAVX2;
+	}
+#endif
+#ifdef HEX_BLEND_SSE2
+	return _BlendSSE2;
+#else
+	return _BlendScalar;
+#endif
+}
+}
+
+void HXBlendRow(HXBuffer *Target, const HXBuffer *Source, size_t Count, HXColInt Opacity) {
+	static const _BlendKernel kernel = _SelectBlendKernel();
+
+	kernel(Target, Source, Count, Opacity);
+}
+
+void HXMixRow(uint32_t *Target, const uint32_t *Source, size_t Count, HXColInt Opacity) {
+#ifdef HEX_BLEND_SSE2
+	_MixSSE2(Target, Source, Count, Opacity);
+#else
+	_MixScalar(Target, Source, Count, Opacity);
+#endif
+}
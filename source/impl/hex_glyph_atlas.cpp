@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025 HiEasyX
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * \file hex_glyph_atlas.cpp
+ * \brief The glyph cache shared by the implementations
+ */
+
+#include <include/impl/hex_glyph_atlas.h>
+
+#include <algorithm>
+#include <cstring>
+
+const HXGlyph *HXGlyphAtlas::Find(const HXGlyphKey &Key) const {
+	const auto glyph = _glyphs.find(Key);
+
+	return glyph != _glyphs.end() ? &glyph->second : nullptr;
+}
+
+const HXGlyph &HXGlyphAtlas::Insert(const HXGlyphKey &Key, HXGInt Width, HXGInt Height, HXGInt Advance,
+                                    const uint8_t *Coverage) {
+	// A glyph larger than a page is cropped, which only happens with absurd
+	// font heights, the rows of the coverage keep their original stride
+	const auto stride = static_cast<size_t>(std::max<HXGInt>(Width, 0));
+
+	Width  = std::clamp<HXGInt>(Width, 0, PageSize);
+	Height = std::clamp<HXGInt>(Height, 0, PageSize);
+
+	if (_shelfX + Width > PageSize) {
+		_shelfX = 0;
+		_shelfY += _shelfHeight;
+		_shelfHeight = 0;
+	}
+	if (_pages.empty() || _shelfY + Height > PageSize) {
+		if (_pages.size() >= MaxPages) {
+			Flush();
+		}
+
+		_pages.emplace_back(static_cast<size_t>(PageSize) * PageSize);
+		_shelfX      = 0;
+		_shelfY      = 0;
+		_shelfHeight = 0;
+	}
+
+	auto &page = _pages.back();
+	for (HXGInt y = 0; y < Height; ++y) {
+		std::memcpy(page.data() + static_cast<size_t>(_shelfY + y) * PageSize + _shelfX,
+		            Coverage + static_cast<size_t>(y) * stride, static_cast<size_t>(Width));
+	}
+
+	const auto glyph = HXGlyph{.Page    = static_cast<uint32_t>(_pages.size() - 1),
+	                           .X       = _shelfX,
+	                           .Y       = _shelfY,
+	                           .Width   = Width,
+	                           .Height  = Height,
+	                           .Advance = Advance};
+
+	_shelfX += Width;
+	_shelfHeight = std::max(_shelfHeight, Height);
+
+	return _glyphs.insert_or_assign(Key, glyph).first->second;
+}
+
+const uint8_t *HXGlyphAtlas::Coverage(const HXGlyph &Glyph) const {
+	return _pages[Glyph.Page].data() + static_cast<size_t>(Glyph.Y) * PageSize + Glyph.X;
+}
+
+size_t HXGlyphAtlas::Size() const {
+	return _glyphs.size();
+}
+
+void HXGlyphAtlas::Flush() {
+	_glyphs.clear();
+	_pages.clear();
+
+	_shelfX      = 0;
+	_shelfY      = 0;
+	_shelfHeight = 0;
+}